@@ -0,0 +1,90 @@
+// Allocation benchmark: heap allocations and time per call for flight search and
+// booking history, std::vector overloads against the std::pmr overloads backed
+// by a stack arena.
+//
+// Usage: ./bench/alloc_bench [calls]   (default 1000)
+
+#include "dal/SqliteDatabaseManager.h"
+#include "bll/ReservationService.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+
+static const char* kBenchDb = "bench_alloc.db";
+
+// Every global operator new is counted; SQLite's own malloc calls are not.
+static size_t allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+template <typename Fn>
+static void measure(const char* name, int calls, Fn fn) {
+    fn(); // Warm up the statement cache and SQLite's page cache
+    size_t before = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) {
+        fn();
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-24s %8.1f allocs/call %8.1f us/call\n", name, (double)(allocationCount - before) / calls, us / calls);
+}
+
+int main(int argc, char* argv[]) {
+    const int calls = argc > 1 ? std::atoi(argv[1]) : 1000;
+    // Long enough that every string spills out of the small-string buffer.
+    const std::string origin = "New Delhi International";
+    const std::string destination = "Mumbai Chhatrapati Shivaji";
+    const std::string email = "someone.with.long.email@example.com";
+
+    try {
+        std::remove(kBenchDb);
+        auto dbManager = std::make_unique<SqliteDatabaseManager>(kBenchDb);
+        dbManager->initialize();
+        ReservationService service(std::move(dbManager));
+
+        // 1. Seed 40 flights on one route and one booking on each for the same passenger
+        for (int i = 0; i < 40; ++i) {
+            service.addNewFlight(Flight{0, "ALLOC-BENCH-" + std::to_string(i), origin, destination, "2099-12-01 10:00", 180, 180, 100.0});
+            service.bookFlight(i + 1, "A Passenger With A Long Name", email);
+        }
+
+        // 2. Search and history, with and without an arena
+        measure("search (std::vector)", calls, [&] {
+            auto flights = service.findAvailableFlights(origin, destination);
+        });
+        measure("search (pmr arena)", calls, [&] {
+            alignas(std::max_align_t) std::array<std::byte, 64 * 1024> buffer;
+            std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+            auto flights = service.findAvailableFlights(origin, destination, &arena);
+        });
+        measure("history (std::vector)", calls, [&] {
+            auto bookings = service.findMyBookings(email);
+        });
+        measure("history (pmr arena)", calls, [&] {
+            alignas(std::max_align_t) std::array<std::byte, 64 * 1024> buffer;
+            std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+            auto bookings = service.findMyBookings(email, &arena);
+        });
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        std::remove(kBenchDb);
+        return 1;
+    }
+
+    std::remove(kBenchDb);
+    return 0;
+} 
\ No newline at end of file
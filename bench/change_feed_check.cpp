@@ -0,0 +1,235 @@
+// Change feed check. Exits non-zero on any failure.
+//
+// Part 1 hammers a bare ChangeFeed: one producer publishes events whose payload is a
+// function of their sequence while several readers poll in random batches, stalling now
+// and then so they overflow. Every event a reader receives must be in sequence order
+// and carry the payload of its own sequence; a torn or stale slot shows up as a bad event.
+//
+// Part 2 drives ReservationService on one thread while a reader on another keeps a
+// seat and fare cache up to date from the feed alone: it resyncs from changeSnapshot()
+// on overflow and fills in FlightAdded/PriceChanged with committedFlight(). Bulk
+// repricing publishes more events than the feed holds, so the reader is forced to
+// resync. At the end its cache must match the database.
+//
+// Usage: ./bench/change_feed_check [events]   (default 2000000)
+// For a data race check, build with -fsanitize=thread:
+//   make clean check CXXFLAGS="-std=c++17 -O1 -g -fsanitize=thread -I./src" LDFLAGS="-lsqlite3 -pthread -fsanitize=thread"
+
+#include "dal/SqliteDatabaseManager.h"
+#include "bll/ReservationService.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char* kCheckDb = "check_change_feed.db";
+
+// Payload derived from the sequence, so a reader can tell whether a slot is intact.
+static int flightFor(uint64_t sequence) { return (int)(sequence % 1000003); }
+static int bookingFor(uint64_t sequence) { return (int)(sequence % 7919); }
+static int seatsFor(uint64_t sequence) { return (int)((sequence * 31) % 100000); }
+
+struct ReaderResult {
+    uint64_t events = 0;
+    uint64_t overflows = 0;
+    uint64_t badEvents = 0;
+};
+
+static bool checkRingBuffer(uint64_t eventCount) {
+    const int kReaders = 3;
+    // A small ring keeps every reader close to a lap boundary.
+    ChangeFeed feed(64);
+    std::atomic<bool> done{false};
+    std::vector<ReaderResult> results(kReaders);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; ++r) {
+        readers.emplace_back([&, r] {
+            std::mt19937 rng(r + 1);
+            ReaderResult& result = results[r];
+            std::vector<ChangeEvent> events;
+            uint64_t nextSequence = 1;
+            while (true) {
+                bool finished = done.load(std::memory_order_acquire);
+                events.clear();
+                uint64_t expected = nextSequence == 0 ? 1 : nextSequence;
+                auto status = feed.poll(nextSequence, events, 1 + rng() % 64);
+                for (const auto& e : events) {
+                    if (e.sequence != expected++ || e.flightId != flightFor(e.sequence) ||
+                        e.bookingId != bookingFor(e.sequence) || e.availableSeats != seatsFor(e.sequence) ||
+                        e.type != (ChangeType)(e.sequence % 5)) {
+                        ++result.badEvents;
+                    }
+                }
+                result.events += events.size();
+                if (status == ChangeFeed::PollResult::Overflow) {
+                    // A bare feed has no snapshot. Resume at the oldest slot still in the
+                    // ring, right behind the producer, so reads keep racing its overwrites.
+                    ++result.overflows;
+                    uint64_t last = feed.lastSequence();
+                    nextSequence = last > feed.capacity() ? last - feed.capacity() + 2 : 1;
+                    continue;
+                }
+                if (finished && nextSequence > feed.lastSequence()) break;
+                // Stall now and then so the producer laps this reader.
+                if (rng() % 4096 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        });
+    }
+
+    for (uint64_t sequence = 1; sequence <= eventCount; ++sequence) {
+        feed.publish((ChangeType)(sequence % 5), flightFor(sequence), bookingFor(sequence), seatsFor(sequence));
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) reader.join();
+
+    bool ok = true;
+    for (int r = 0; r < kReaders; ++r) {
+        std::printf("ring reader %d: %llu events, %llu overflows, %llu bad\n", r,
+                    (unsigned long long)results[r].events, (unsigned long long)results[r].overflows,
+                    (unsigned long long)results[r].badEvents);
+        ok = ok && results[r].badEvents == 0 && results[r].events > 0;
+    }
+    return ok;
+}
+
+struct CachedFlight {
+    int availableSeats;
+    double price;
+};
+
+static bool checkServiceResync() {
+    const int kSeedFlights = 4500; // More than the service feed's 4096 slots
+    std::remove(kCheckDb);
+    auto dbManager = std::make_unique<SqliteDatabaseManager>(kCheckDb);
+    dbManager->initialize();
+
+    // 1. Seed the schedule in one transaction, before the feed exists
+    dbManager->beginTransaction();
+    for (int i = 0; i < kSeedFlights; ++i) {
+        dbManager->addFlight(Flight{0, "CF" + std::to_string(i), "O" + std::to_string(i % 20), "D" + std::to_string(i % 7),
+                                    "2099-12-01 10:00", 20, 20, 100.0});
+    }
+    dbManager->commitTransaction();
+    ReservationService service(std::move(dbManager));
+
+    // 2. Reader: a seat and fare cache maintained from the feed alone
+    std::atomic<bool> done{false};
+    std::map<int, CachedFlight> cache;
+    uint64_t resyncs = 0, failedReads = 0, events = 0;
+    std::thread reader([&] {
+        std::vector<ChangeEvent> batch;
+        uint64_t nextSequence = 0;
+        bool needResync = true;
+        while (true) {
+            bool finished = done.load(std::memory_order_acquire);
+            if (needResync) {
+                auto snapshot = service.changeSnapshot();
+                if (!snapshot) {
+                    ++failedReads;
+                    if (finished) break;
+                    continue;
+                }
+                cache.clear();
+                for (const auto& f : snapshot->flights) {
+                    cache[f.id] = CachedFlight{f.availableSeats, f.price};
+                }
+                nextSequence = snapshot->sequence + 1;
+                needResync = false;
+                ++resyncs;
+            }
+
+            batch.clear();
+            if (service.changeFeed().poll(nextSequence, batch, 256) == ChangeFeed::PollResult::Overflow) {
+                needResync = true;
+                continue;
+            }
+            for (const auto& e : batch) {
+                CachedFlight& cached = cache[e.flightId];
+                cached.availableSeats = e.availableSeats;
+                if (e.type == ChangeType::FlightAdded || e.type == ChangeType::PriceChanged) {
+                    auto flight = service.committedFlight(e.flightId);
+                    if (flight) cached.price = flight->price;
+                    else ++failedReads;
+                }
+            }
+            events += batch.size();
+            if (finished && batch.empty()) break;
+        }
+    });
+
+    // 3. Writer: bookings, cancellations, holds, new flights and bulk repricing
+    std::vector<int> bookings;
+    for (int i = 0; i < 3000; ++i) {
+        int flightId = 1 + i % 50;
+        switch (i % 6) {
+        case 0: {
+            auto token = service.holdSeats(flightId, 2, std::chrono::minutes(5));
+            if (token && i % 4 == 0) service.confirmHold(*token, {Passenger{"Check", "check@example.com"}});
+            else if (token) service.releaseHold(*token);
+            break;
+        }
+        case 1:
+        case 2: {
+            auto bookingId = service.bookFlight(flightId, "Check", "check@example.com");
+            if (bookingId) bookings.push_back(*bookingId);
+            break;
+        }
+        case 3:
+            if (!bookings.empty()) {
+                service.cancelBooking(bookings.back());
+                bookings.pop_back();
+            }
+            break;
+        case 4:
+            service.addNewFlight(Flight{0, "CN" + std::to_string(i), "O1", "D1", "2099-12-02 10:00", 20, 20, 150.0});
+            break;
+        default:
+            if (i % 600 == 5) service.repriceAllFlights();
+            break;
+        }
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    // 4. The cache must now match the database exactly
+    int mismatched = 0;
+    auto flights = service.getAllFlights();
+    for (const auto& f : flights) {
+        auto cached = cache.find(f.id);
+        if (cached == cache.end() || cached->second.availableSeats != f.availableSeats || cached->second.price != f.price) {
+            ++mismatched;
+        }
+    }
+    if (cache.size() != flights.size()) ++mismatched;
+
+    std::printf("service reader: %llu events, %llu resyncs, %llu failed reads, %d mismatched of %zu flights\n",
+                (unsigned long long)events, (unsigned long long)resyncs, (unsigned long long)failedReads,
+                mismatched, flights.size());
+    // The initial sync counts as one; repricing must have forced at least one more.
+    return mismatched == 0 && failedReads == 0 && resyncs > 1;
+}
+
+int main(int argc, char* argv[]) {
+    const uint64_t eventCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+    bool ok = false;
+    try {
+        bool ringOk = checkRingBuffer(eventCount);
+        bool serviceOk = checkServiceResync();
+        ok = ringOk && serviceOk;
+    } catch (const std::exception& e) {
+        std::cerr << "Check failed: " << e.what() << std::endl;
+    }
+
+    std::remove(kCheckDb);
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+} 
\ No newline at end of file
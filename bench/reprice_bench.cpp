@@ -0,0 +1,125 @@
+// Repricing benchmark: the bulk column path of ReservationService::repriceAllFlights()
+// against a per-row baseline built from Flight objects.
+//
+// Usage: ./bench/reprice_bench [flights]   (default 1000000)
+
+#include "dal/SqliteDatabaseManager.h"
+#include "bll/ReservationService.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+static const char* kBenchDb = "bench_reprice.db";
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Local departure time a given number of days from now, in the schedule's format.
+static std::string departureInDays(int days) {
+    std::time_t t = std::time(nullptr) + (std::time_t)days * 24 * 3600;
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%d 10:00", std::localtime(&t));
+    return buf;
+}
+
+static double hoursUntil(const std::string& departureTime) {
+    std::tm tm{};
+    if (std::sscanf(departureTime.c_str(), "%d-%d-%d %d:%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min) != 5) {
+        return -1.0;
+    }
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    tm.tm_isdst = -1;
+    return std::difftime(std::mktime(&tm), std::time(nullptr)) / 3600.0;
+}
+
+// The straightforward implementation: full Flight objects, a map keyed by route and
+// one UPDATE prepared per changed row, all inside one transaction.
+// Every flight is priced from its current fare, which equals BaseFare in this dataset.
+static size_t repricePerRow(IDatabaseManager& db, const FareRules& rules) {
+    db.beginTransaction();
+    auto flights = db.getAllFlights();
+
+    std::map<std::pair<std::string, std::string>, std::pair<double, double>> routes;
+    for (const auto& f : flights) {
+        auto& route = routes[{f.origin, f.destination}];
+        route.first += f.totalSeats - f.availableSeats;
+        route.second += f.totalSeats;
+    }
+
+    size_t changed = 0;
+    for (const auto& f : flights) {
+        double hours = hoursUntil(f.departureTime);
+        if (hours < 0.0) continue;
+        const auto& route = routes[{f.origin, f.destination}];
+        double load = 1.0 - (double)f.availableSeats / std::max(f.totalSeats, 1);
+        double demand = route.first / std::max(route.second, 1.0) - 0.5;
+        double urgency = std::clamp(1.0 - hours / rules.urgencyWindowHours, 0.0, 1.0);
+        double multiplier = std::clamp(1.0 + rules.loadWeight * load + rules.demandWeight * demand + rules.urgencyWeight * urgency,
+                                       rules.minMultiplier, rules.maxMultiplier);
+        double price = std::round(f.price * multiplier * 100.0) / 100.0;
+        if (std::fabs(price - f.price) < 0.005) continue;
+        db.updateFlightPrices({f.id}, {price});
+        ++changed;
+    }
+    db.commitTransaction();
+    return changed;
+}
+
+int main(int argc, char* argv[]) {
+    const int flightCount = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    try {
+        std::remove(kBenchDb);
+        auto dbManager = std::make_unique<SqliteDatabaseManager>(kBenchDb);
+        dbManager->initialize();
+        SqliteDatabaseManager* db = dbManager.get();
+
+        // 1. Seed the schedule: 200 x 97 routes, varied loads, departures over the next month
+        std::cout << "Seeding " << flightCount << " flights...\n";
+        db->beginTransaction();
+        for (int i = 0; i < flightCount; ++i) {
+            db->addFlight(Flight{0, "BF" + std::to_string(i), "O" + std::to_string(i % 200), "D" + std::to_string(i % 97),
+                                 departureInDays(1 + i % 30), 180, 180 - i % 180, 100.0});
+        }
+        db->commitTransaction();
+
+        // 2. Per-row baseline
+        auto start = std::chrono::steady_clock::now();
+        size_t perRowChanged = repricePerRow(*db, FareRules{});
+        double perRowMs = elapsedMs(start);
+
+        // 3. Put every fare back at its base so the bulk path starts from the same state
+        auto cols = db->loadPricingColumns();
+        if (!cols) throw std::runtime_error("Failed to load pricing columns.");
+        db->beginTransaction();
+        db->updateFlightPrices(cols->ids, cols->baseFares);
+        db->commitTransaction();
+
+        // 4. Bulk path
+        ReservationService service(std::move(dbManager));
+        start = std::chrono::steady_clock::now();
+        auto bulkChanged = service.repriceAllFlights();
+        double bulkMs = elapsedMs(start);
+        if (!bulkChanged) throw std::runtime_error("Bulk repricing failed.");
+
+        std::printf("per-row: %8.0f ms  (%zu fares changed)\n", perRowMs, perRowChanged);
+        std::printf("bulk:    %8.0f ms  (%zu fares changed)\n", bulkMs, *bulkChanged);
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        std::remove(kBenchDb);
+        return 1;
+    }
+
+    std::remove(kBenchDb);
+    return 0;
+} 
\ No newline at end of file
@@ -0,0 +1,74 @@
+// Timer wheel check: drives TimerWheel with random schedules, cancels and advances and
+// compares every firing with a brute-force model. Exits non-zero on any early, late
+// or lost timer, so a change to slotFor()/tick() cannot quietly bring back off-by-one
+// firings at level boundaries.
+//
+// Usage: ./bench/timer_wheel_check [operations] [seed]   (default 400000, 7)
+
+#include "bll/TimerWheel.h"
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+
+int main(int argc, char* argv[]) {
+    const int operations = argc > 1 ? std::atoi(argv[1]) : 400000;
+    const unsigned seed = argc > 2 ? (unsigned)std::atoi(argv[2]) : 7;
+
+    std::mt19937_64 rng(seed);
+    long long now = 1000000;
+    TimerWheel wheel(now);
+
+    // Model: timer ID -> the tick it must fire on. Already-due timers fire on the next tick.
+    std::map<int, long long> due;
+    int nextId = 0;
+    long long scheduled = 0, onTime = 0, early = 0, late = 0, unknown = 0;
+
+    for (int op = 0; op < operations; ++op) {
+        int kind = (int)(rng() % 10);
+        if (kind < 6) {
+            // 1. Schedule: mostly near timers, some across the upper levels, a few already due
+            long long range = rng() % 4 == 0 ? 5000000 : 5000;
+            long long expiry = now - 2 + (long long)(rng() % range);
+            wheel.schedule(nextId, expiry);
+            due[nextId++] = expiry > now ? expiry : now + 1;
+            ++scheduled;
+        } else if (kind < 7 && !due.empty()) {
+            // 2. Cancel a random live timer
+            auto it = due.lower_bound((int)(rng() % nextId));
+            if (it == due.end()) it = due.begin();
+            if (!wheel.cancel(it->first)) ++unknown;
+            due.erase(it);
+        } else {
+            // 3. Advance tick by tick, with an occasional long jump through idle time
+            long long target = now + 1 + (long long)(rng() % (rng() % 50 == 0 ? 100000 : 40));
+            for (long long t = now + 1; t <= target; ++t) {
+                for (int id : wheel.advance(t)) {
+                    auto it = due.find(id);
+                    if (it == due.end()) {
+                        ++unknown;
+                        continue;
+                    }
+                    if (it->second == t) ++onTime;
+                    else if (it->second > t) ++early;
+                    else ++late;
+                    due.erase(it);
+                }
+            }
+            now = target;
+        }
+    }
+
+    // Anything the model says is due by now but still pending was lost.
+    long long lost = 0;
+    for (const auto& timer : due) {
+        if (timer.second <= now) ++lost;
+    }
+    bool sizeMatches = wheel.size() == due.size();
+
+    std::printf("timers scheduled: %lld, fired on time: %lld, early: %lld, late: %lld, lost: %lld, unknown: %lld, pending: %zu%s\n",
+                scheduled, onTime, early, late, lost, unknown, due.size(), sizeMatches ? "" : " (size mismatch)");
+    bool ok = early == 0 && late == 0 && lost == 0 && unknown == 0 && sizeMatches;
+    std::printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+} 
\ No newline at end of file
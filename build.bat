@@ -15,12 +15,15 @@ echo Compiling source files...
 g++ -std=c++17 -Wall -Wextra -I./src -I./src/core -I./src/dal -I./src/bll -I./src/ui -I./src/utils -c src/main.cpp -o src/main.o
 g++ -std=c++17 -Wall -Wextra -I./src -I./src/core -I./src/dal -I./src/bll -I./src/ui -I./src/utils -c src/dal/SqliteDatabaseManager.cpp -o src/dal/SqliteDatabaseManager.o
 g++ -std=c++17 -Wall -Wextra -I./src -I./src/core -I./src/dal -I./src/bll -I./src/ui -I./src/utils -c src/bll/ReservationService.cpp -o src/bll/ReservationService.o
+g++ -std=c++17 -Wall -Wextra -I./src -I./src/core -I./src/dal -I./src/bll -I./src/ui -I./src/utils -O3 -fno-trapping-math -c src/bll/PricingEngine.cpp -o src/bll/PricingEngine.o
+g++ -std=c++17 -Wall -Wextra -I./src -I./src/core -I./src/dal -I./src/bll -I./src/ui -I./src/utils -c src/bll/TimerWheel.cpp -o src/bll/TimerWheel.o
+g++ -std=c++17 -Wall -Wextra -I./src -I./src/core -I./src/dal -I./src/bll -I./src/ui -I./src/utils -c src/bll/ChangeFeed.cpp -o src/bll/ChangeFeed.o
 g++ -std=c++17 -Wall -Wextra -I./src -I./src/core -I./src/dal -I./src/bll -I./src/ui -I./src/utils -c src/ui/ConsoleUI.cpp -o src/ui/ConsoleUI.o
 g++ -std=c++17 -Wall -Wextra -I./src -I./src/core -I./src/dal -I./src/bll -I./src/ui -I./src/utils -c src/utils/helpers.cpp -o src/utils/helpers.o
 
 REM Link the executable
 echo Linking executable...
-g++ -std=c++17 -Wall -Wextra -I./src -I./src/core -I./src/dal -I./src/bll -I./src/ui -I./src/utils -o flight_system.exe src/main.o src/dal/SqliteDatabaseManager.o src/bll/ReservationService.o src/ui/ConsoleUI.o src/utils/helpers.o -lsqlite3
+g++ -std=c++17 -Wall -Wextra -I./src -I./src/core -I./src/dal -I./src/bll -I./src/ui -I./src/utils -o flight_system.exe src/main.o src/dal/SqliteDatabaseManager.o src/bll/ReservationService.o src/bll/PricingEngine.o src/bll/TimerWheel.o src/bll/ChangeFeed.o src/ui/ConsoleUI.o src/utils/helpers.o -lsqlite3 -pthread
 
 if %errorlevel% equ 0 (
     echo Build successful! Run flight_system.exe to start the application.
@@ -0,0 +1,57 @@
+#include "ChangeFeed.h"
+
+static size_t roundUpToPowerOfTwo(size_t n) {
+    size_t size = 1;
+    while (size < n) size <<= 1;
+    return size;
+}
+
+ChangeFeed::ChangeFeed(size_t capacity) {
+    size_t size = roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity);
+    slots = std::make_unique<Slot[]>(size);
+    mask = size - 1;
+}
+
+uint64_t ChangeFeed::publish(ChangeType type, int flightId, int bookingId, int availableSeats) {
+    uint64_t sequence = head.load(std::memory_order_relaxed) + 1;
+    Slot& slot = slots[sequence & mask];
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.typeAndFlight.store((uint64_t)type << 32 | (uint32_t)flightId, std::memory_order_relaxed);
+    slot.bookingAndSeats.store((uint64_t)(uint32_t)bookingId << 32 | (uint32_t)availableSeats, std::memory_order_relaxed);
+    slot.sequence.store(sequence, std::memory_order_release);
+
+    head.store(sequence, std::memory_order_release);
+    return sequence;
+}
+
+ChangeFeed::PollResult ChangeFeed::poll(uint64_t& nextSequence, std::vector<ChangeEvent>& out, size_t maxEvents) const {
+    uint64_t last = head.load(std::memory_order_acquire);
+    if (nextSequence == 0) nextSequence = 1;
+
+    for (size_t copied = 0; copied < maxEvents && nextSequence <= last; ++copied) {
+        // The slot for nextSequence has been reused once the writer is a full lap ahead.
+        if (last - nextSequence >= capacity()) return PollResult::Overflow;
+
+        const Slot& slot = slots[nextSequence & mask];
+        uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        uint64_t typeAndFlight = slot.typeAndFlight.load(std::memory_order_relaxed);
+        uint64_t bookingAndSeats = slot.bookingAndSeats.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+
+        // Overwritten while we were reading it.
+        if (before != nextSequence || after != nextSequence) return PollResult::Overflow;
+
+        out.push_back(ChangeEvent{
+            nextSequence,
+            (ChangeType)(typeAndFlight >> 32),
+            (int)(uint32_t)typeAndFlight,
+            (int)(uint32_t)(bookingAndSeats >> 32),
+            (int)(uint32_t)bookingAndSeats
+        });
+        ++nextSequence;
+    }
+    return PollResult::Ok;
+} 
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef CHANGE_FEED_H
+#define CHANGE_FEED_H
+
+#include "../core/models.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Bounded single-producer/multi-consumer ring buffer of committed changes.
+// The service thread publishes; any number of readers tail it independently, each
+// keeping its own next sequence number, without locks on either side. A reader that
+// falls more than `capacity` events behind gets Overflow and must resync:
+//   1. call ReservationService::changeSnapshot(),
+//   2. rebuild its state from snapshot.flights,
+//   3. resume polling at snapshot.sequence + 1.
+// Events carry absolute seat counts, so replaying ones the snapshot already reflects is harmless.
+// FlightAdded and PriceChanged carry only the flight ID and seat count; readers fill in the
+// rest with ReservationService::committedFlight(), which is safe from their own thread.
+class ChangeFeed {
+public:
+    enum class PollResult { Ok, Overflow };
+
+    explicit ChangeFeed(size_t capacity = 4096);
+
+    // Producer side; must only be called from one thread.
+    uint64_t publish(ChangeType type, int flightId, int bookingId, int availableSeats);
+
+    uint64_t lastSequence() const { return head.load(std::memory_order_acquire); }
+    size_t capacity() const { return mask + 1; }
+
+    // Appends up to `maxEvents` events, starting at `nextSequence`, to `out` and advances
+    // `nextSequence` past them. Safe to call concurrently from any number of readers.
+    PollResult poll(uint64_t& nextSequence, std::vector<ChangeEvent>& out, size_t maxEvents = SIZE_MAX) const;
+
+private:
+    // Each slot is a seqlock: `sequence` is 0 while the slot is being rewritten.
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> typeAndFlight{0};
+        std::atomic<uint64_t> bookingAndSeats{0};
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    std::atomic<uint64_t> head{0};
+};
+
+#endif // CHANGE_FEED_H 
\ No newline at end of file
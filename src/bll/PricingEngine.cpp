@@ -0,0 +1,51 @@
+#include "PricingEngine.h"
+#include <algorithm>
+#include <cmath>
+
+PricingEngine::PricingEngine(const FareRules& rules) : rules(rules) {}
+
+void PricingEngine::reprice(const FlightPricingColumns& cols, std::vector<int>& changedIds, std::vector<double>& changedPrices) const {
+    const size_t n = cols.size();
+    const int* total = cols.totalSeats.data();
+    const int* available = cols.availableSeats.data();
+    const int* route = cols.routeIndex.data();
+    const double* hours = cols.hoursToDeparture.data();
+    const double* base = cols.baseFares.data();
+    const double* current = cols.prices.data();
+
+    // 1. Route demand: seats sold over seats offered across each route.
+    std::vector<double> routeSold(cols.routeCount, 0.0);
+    std::vector<double> routeTotal(cols.routeCount, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        routeSold[route[i]] += total[i] - available[i];
+        routeTotal[route[i]] += total[i];
+    }
+    std::vector<double> routeLoad(cols.routeCount);
+    for (int r = 0; r < cols.routeCount; ++r) {
+        routeLoad[r] = routeSold[r] / std::max(routeTotal[r], 1.0);
+    }
+
+    // 2. Fare rules, one flight per lane.
+    std::vector<double> fares(n);
+    double* fare = fares.data();
+    const double invWindow = 1.0 / rules.urgencyWindowHours;
+    for (size_t i = 0; i < n; ++i) {
+        double seats = std::max((double)total[i], 1.0);
+        double load = (seats - available[i]) / seats;
+        double urgency = std::clamp(1.0 - hours[i] * invWindow, 0.0, 1.0);
+        double demand = routeLoad[route[i]] - 0.5;
+        double multiplier = 1.0 + rules.loadWeight * load + rules.demandWeight * demand + rules.urgencyWeight * urgency;
+        multiplier = std::clamp(multiplier, rules.minMultiplier, rules.maxMultiplier);
+        double repriced = base[i] * multiplier;
+        double unchanged = current[i];
+        fare[i] = hours[i] < 0.0 ? unchanged : repriced;
+    }
+
+    // 3. Collect only the rows that moved by at least a cent, rounded to cents.
+    for (size_t i = 0; i < n; ++i) {
+        if (std::fabs(fare[i] - current[i]) >= 0.005) {
+            changedIds.push_back(cols.ids[i]);
+            changedPrices.push_back(std::round(fare[i] * 100.0) / 100.0);
+        }
+    }
+} 
\ No newline at end of file
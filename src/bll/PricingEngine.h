@@ -0,0 +1,34 @@
+#ifndef PRICING_ENGINE_H
+#define PRICING_ENGINE_H
+
+#include "../core/models.h"
+#include <vector>
+
+// Tunable fare rules. A flight's fare is its base fare scaled by a multiplier
+// built from its own load factor, the load factor of its route and how close
+// it is to departure.
+struct FareRules {
+    double loadWeight = 0.6;            // Added at 100% load on this flight
+    double demandWeight = 0.3;          // Per unit of route load above 50%
+    double urgencyWeight = 0.4;         // Added at the moment of departure
+    double urgencyWindowHours = 14 * 24; // Urgency starts ramping up inside this window
+    double minMultiplier = 0.7;
+    double maxMultiplier = 2.5;
+};
+
+// Evaluates the fare rules over a whole schedule at once.
+// All loops run over contiguous columns without branches so the compiler can vectorize them.
+class PricingEngine {
+public:
+    explicit PricingEngine(const FareRules& rules = FareRules{});
+
+    // Computes the new fare of every flight in `cols` and appends the flights whose
+    // price changed by at least a cent to `changedIds`/`changedPrices`.
+    // Departed flights keep their current price.
+    void reprice(const FlightPricingColumns& cols, std::vector<int>& changedIds, std::vector<double>& changedPrices) const;
+
+private:
+    FareRules rules;
+};
+
+#endif // PRICING_ENGINE_H 
\ No newline at end of file
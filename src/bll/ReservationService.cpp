@@ -1,22 +1,159 @@
 #include "ReservationService.h"
 #include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <tuple>
+
+static long long unixNow() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
 
 ReservationService::ReservationService(std::unique_ptr<IDatabaseManager> dbManager)
-    : db(std::move(dbManager)) {}
+    : db(std::move(dbManager)), holdTimers(unixNow() - 1) {
+    for (auto& entry : db->getWaitlistEntries()) {
+        waitlists[entry.flightId].push_back(std::move(entry));
+    }
+
+    // Holds survive a restart. The wheel starts one tick back, so any that lapsed
+    // while we were down expire on the very first call.
+    for (auto& hold : db->getSeatHolds()) {
+        holdTimers.schedule(hold.id, hold.expiresAt);
+        holdIdsByToken[hold.token] = hold.id;
+        holds.emplace(hold.id, std::move(hold));
+    }
+}
 
 bool ReservationService::addNewFlight(const Flight& flight) {
-    return db->addFlight(flight);
+    auto flightIdOpt = db->addFlight(flight);
+    if (!flightIdOpt) return false;
+    changes.publish(ChangeType::FlightAdded, *flightIdOpt, 0, flight.availableSeats);
+    return true;
 }
 
 std::vector<Flight> ReservationService::getAllFlights() {
+    releaseExpiredHolds();
     return db->getAllFlights();
 }
 
+std::optional<size_t> ReservationService::repriceAllFlights() {
+    if (!db->beginTransaction()) return std::nullopt;
+
+    // 1. Load the pricing columns and evaluate the fare rules in bulk
+    auto colsOpt = db->loadPricingColumns();
+    if (!colsOpt) {
+        db->rollbackTransaction();
+        return std::nullopt;
+    }
+    std::vector<int> changedIds;
+    std::vector<double> changedPrices;
+    pricing.reprice(*colsOpt, changedIds, changedPrices);
+
+    // 2. Write back only the changed fares in a single batch
+    if (!changedIds.empty() && !db->updateFlightPrices(changedIds, changedPrices)) {
+        db->rollbackTransaction();
+        return std::nullopt;
+    }
+
+    if (!db->commitTransaction()) return std::nullopt;
+
+    // 3. Publish the new fares. Changed flights come back in column order, so one
+    //    pass over the columns finds each one's seat count for the event.
+    const FlightPricingColumns& cols = *colsOpt;
+    size_t row = 0;
+    for (int flightId : changedIds) {
+        while (cols.ids[row] != flightId) ++row;
+        changes.publish(ChangeType::PriceChanged, flightId, 0, cols.availableSeats[row]);
+    }
+
+    return changedIds.size();
+}
+
+std::optional<ChangeSnapshot> ReservationService::changeSnapshot() {
+    // Take the sequence first: every change up to it is committed, so the read below sees it.
+    // Only the feed and the DAL's committed read are touched, never the hold timers.
+    uint64_t sequence = changes.lastSequence();
+    auto flights = db->getCommittedFlights();
+    if (!flights) return std::nullopt;
+    return ChangeSnapshot{sequence, std::move(*flights)};
+}
+
+std::optional<Flight> ReservationService::committedFlight(int flightId) {
+    return db->getCommittedFlight(flightId);
+}
+
+std::vector<RouteStats> ReservationService::getRouteReport() {
+    // Roll the daily rows up per route; they arrive ordered by route already.
+    std::vector<RouteStats> report;
+    for (const auto& day : db->getRouteDailyStats()) {
+        if (report.empty() || report.back().origin != day.origin || report.back().destination != day.destination) {
+            report.push_back(RouteStats{day.origin, day.destination, "", 0, 0, 0, 0.0, 0, 0});
+        }
+        RouteStats& route = report.back();
+        route.flights += day.flights;
+        route.seatsOffered += day.seatsOffered;
+        route.seatsSold += day.seatsSold;
+        route.revenue += day.revenue;
+        route.bookings += day.bookings;
+        route.cancellations += day.cancellations;
+    }
+    return report;
+}
+
+std::vector<RouteStats> ReservationService::getDailyRouteReport() {
+    return db->getRouteDailyStats();
+}
+
+bool ReservationService::verifyRouteStats() {
+    using Key = std::tuple<std::string, std::string, std::string>;
+    std::map<Key, RouteStats> stored;
+    for (auto& s : db->getRouteDailyStats()) {
+        stored.emplace(Key{s.origin, s.destination, s.departureDay}, s);
+    }
+
+    bool consistent = true;
+    auto report = [&](const RouteStats& s, const std::string& problem) {
+        std::cerr << "Route stats mismatch for " << s.origin << " -> " << s.destination
+                  << " on " << s.departureDay << ": " << problem << std::endl;
+        consistent = false;
+    };
+
+    // Cancelled bookings are gone from the base tables, so gross bookings and
+    // cancellations are checked through their difference, which must equal seats sold.
+    for (const auto& expected : db->recomputeRouteDailyStats()) {
+        auto it = stored.find(Key{expected.origin, expected.destination, expected.departureDay});
+        if (it == stored.end()) {
+            report(expected, "missing");
+            continue;
+        }
+        const RouteStats& actual = it->second;
+        if (actual.flights != expected.flights) report(expected, "flights");
+        if (actual.seatsOffered != expected.seatsOffered) report(expected, "seats offered");
+        if (actual.seatsSold != expected.seatsSold) report(expected, "seats sold");
+        if (actual.bookings - actual.cancellations != expected.seatsSold) report(expected, "bookings less cancellations");
+        if (std::fabs(actual.revenue - expected.revenue) >= 0.005) report(expected, "revenue");
+        stored.erase(it);
+    }
+    for (const auto& extra : stored) {
+        if (extra.second.flights != 0) report(extra.second, "no matching flights");
+    }
+    return consistent;
+}
+
 std::vector<Flight> ReservationService::findAvailableFlights(const std::string& origin, const std::string& destination) {
+    releaseExpiredHolds();
     return db->searchFlights(origin, destination);
 }
 
+std::pmr::vector<PmrFlight> ReservationService::findAvailableFlights(const std::string& origin, const std::string& destination, std::pmr::memory_resource* resource) {
+    releaseExpiredHolds();
+    return db->searchFlights(origin, destination, resource);
+}
+
 std::optional<int> ReservationService::bookFlight(int flightId, const std::string& passengerName, const std::string& passengerEmail) {
+    releaseExpiredHolds();
     // Transactional logic is now in the service layer, where it belongs.
     if (!db->beginTransaction()) return std::nullopt;
 
@@ -43,10 +180,12 @@ std::optional<int> ReservationService::bookFlight(int flightId, const std::strin
 
     if (!db->commitTransaction()) return std::nullopt;
 
+    changes.publish(ChangeType::BookingCreated, flightId, *bookingIdOpt, flightOpt->availableSeats - 1);
     return bookingIdOpt;
 }
 
 bool ReservationService::cancelBooking(int bookingId) {
+    releaseExpiredHolds();
     if (!db->beginTransaction()) return false;
 
     // 1. Get booking to find the flight ID
@@ -63,15 +202,252 @@ bool ReservationService::cancelBooking(int bookingId) {
         return false;
     }
 
-    // 3. Increment the flight's seat count
-    if (!db->updateFlightSeatCount(bookingOpt->flightId, +1)) {
+    // 3. Hand the seat to the head of the waitlist, or release it
+    std::vector<Promotion> promotions;
+    int availableSeats;
+    if (!releaseSeats(bookingOpt->flightId, 1, promotions, availableSeats)) {
         db->rollbackTransaction();
         return false;
     }
 
-    return db->commitTransaction();
+    if (!db->commitTransaction()) return false;
+
+    changes.publish(ChangeType::BookingCancelled, bookingOpt->flightId, bookingId, availableSeats);
+    applyPromotions(promotions, availableSeats);
+    return true;
 }
 
 std::vector<Booking> ReservationService::findMyBookings(const std::string& passengerEmail) {
     return db->getBookingsForPassenger(passengerEmail);
+}
+
+std::pmr::vector<PmrBooking> ReservationService::findMyBookings(const std::string& passengerEmail, std::pmr::memory_resource* resource) {
+    return db->getBookingsForPassenger(passengerEmail, resource);
+}
+
+std::optional<int> ReservationService::joinWaitlist(int flightId, const std::string& passengerName, const std::string& passengerEmail) {
+    releaseExpiredHolds();
+    if (!db->beginTransaction()) return std::nullopt;
+
+    // 1. Only full flights have a waitlist
+    auto flightOpt = db->getFlightById(flightId);
+    if (!flightOpt || flightOpt->availableSeats > 0) {
+        std::cerr << "Waitlist failed: Flight not found or still has seats." << std::endl;
+        db->rollbackTransaction();
+        return std::nullopt;
+    }
+
+    // 2. Queue the passenger
+    auto entryIdOpt = db->addWaitlistEntry(flightId, passengerName, passengerEmail);
+    if (!entryIdOpt) {
+        db->rollbackTransaction();
+        return std::nullopt;
+    }
+
+    if (!db->commitTransaction()) return std::nullopt;
+
+    waitlists[flightId].push_back(WaitlistEntry{*entryIdOpt, flightId, passengerName, passengerEmail});
+    return entryIdOpt;
+}
+
+bool ReservationService::leaveWaitlist(int entryId) {
+    for (auto waitlist = waitlists.begin(); waitlist != waitlists.end(); ++waitlist) {
+        auto& queue = waitlist->second;
+        for (auto entry = queue.begin(); entry != queue.end(); ++entry) {
+            if (entry->id != entryId) continue;
+            if (!db->deleteWaitlistEntry(entryId)) return false;
+            queue.erase(entry);
+            if (queue.empty()) waitlists.erase(waitlist);
+            return true;
+        }
+    }
+    std::cerr << "Waitlist removal failed: Entry not found." << std::endl;
+    return false;
+}
+
+int ReservationService::subscribeToPromotions(PromotionCallback callback) {
+    int subscriptionId = nextSubscriptionId++;
+    promotionSubscribers.emplace(subscriptionId, std::move(callback));
+    return subscriptionId;
+}
+
+void ReservationService::unsubscribeFromPromotions(int subscriptionId) {
+    promotionSubscribers.erase(subscriptionId);
+}
+
+std::optional<std::string> ReservationService::holdSeats(int flightId, int seats, std::chrono::seconds ttl) {
+    releaseExpiredHolds();
+    if (seats <= 0) return std::nullopt;
+    if (!db->beginTransaction()) return std::nullopt;
+
+    // 1. Check for enough available seats
+    auto flightOpt = db->getFlightById(flightId);
+    if (!flightOpt || flightOpt->availableSeats < seats) {
+        std::cerr << "Hold failed: Not enough available seats or flight not found." << std::endl;
+        db->rollbackTransaction();
+        return std::nullopt;
+    }
+
+    // 2. Take the seats out of availability right away
+    if (!db->updateFlightSeatCount(flightId, -seats)) {
+        db->rollbackTransaction();
+        return std::nullopt;
+    }
+
+    // 3. Record the hold so it can be recovered after a restart
+    char token[17];
+    std::snprintf(token, sizeof(token), "%08x%08x", (unsigned)tokenSource(), (unsigned)tokenSource());
+    SeatHold hold{0, token, flightId, seats, unixNow() + ttl.count()};
+    auto holdIdOpt = db->addSeatHold(hold);
+    if (!holdIdOpt) {
+        db->rollbackTransaction();
+        return std::nullopt;
+    }
+
+    if (!db->commitTransaction()) return std::nullopt;
+
+    changes.publish(ChangeType::SeatsChanged, flightId, 0, flightOpt->availableSeats - seats);
+    hold.id = *holdIdOpt;
+    holdTimers.schedule(hold.id, hold.expiresAt);
+    holdIdsByToken[hold.token] = hold.id;
+    holds.emplace(hold.id, hold);
+    return hold.token;
+}
+
+std::optional<std::vector<int>> ReservationService::confirmHold(const std::string& holdToken, const std::vector<Passenger>& passengers) {
+    releaseExpiredHolds();
+
+    auto token = holdIdsByToken.find(holdToken);
+    if (token == holdIdsByToken.end()) {
+        std::cerr << "Confirmation failed: Hold not found or expired." << std::endl;
+        return std::nullopt;
+    }
+    const SeatHold& hold = holds.at(token->second);
+    if (passengers.empty() || (int)passengers.size() > hold.seats) {
+        std::cerr << "Confirmation failed: Passenger count does not match the hold." << std::endl;
+        return std::nullopt;
+    }
+
+    if (!db->beginTransaction()) return std::nullopt;
+
+    // 1. Book each passenger into a held seat
+    std::vector<int> bookingIds;
+    for (const auto& passenger : passengers) {
+        auto bookingIdOpt = db->addBooking(hold.flightId, passenger.name, passenger.email);
+        if (!bookingIdOpt) {
+            db->rollbackTransaction();
+            return std::nullopt;
+        }
+        bookingIds.push_back(*bookingIdOpt);
+    }
+
+    // 2. Drop the hold and release any seats left unused
+    std::vector<Promotion> promotions;
+    int availableSeats;
+    if (!db->deleteSeatHold(hold.id) ||
+        !releaseSeats(hold.flightId, hold.seats - (int)passengers.size(), promotions, availableSeats)) {
+        db->rollbackTransaction();
+        return std::nullopt;
+    }
+
+    if (!db->commitTransaction()) return std::nullopt;
+
+    for (int bookingId : bookingIds) {
+        changes.publish(ChangeType::BookingCreated, hold.flightId, bookingId, availableSeats);
+    }
+    holdTimers.cancel(hold.id);
+    forgetHold(hold.id);
+    applyPromotions(promotions, availableSeats);
+    return bookingIds;
+}
+
+bool ReservationService::releaseHold(const std::string& holdToken) {
+    releaseExpiredHolds();
+
+    auto token = holdIdsByToken.find(holdToken);
+    if (token == holdIdsByToken.end()) {
+        std::cerr << "Release failed: Hold not found or expired." << std::endl;
+        return false;
+    }
+    int holdId = token->second;
+    if (!returnHeldSeats(holds.at(holdId))) return false;
+    holdTimers.cancel(holdId);
+    forgetHold(holdId);
+    return true;
+}
+
+void ReservationService::releaseExpiredHolds() {
+    long long now = unixNow();
+    for (int holdId : holdTimers.advance(now)) {
+        auto hold = holds.find(holdId);
+        if (hold == holds.end()) continue;
+        if (returnHeldSeats(hold->second)) {
+            forgetHold(holdId);
+        } else {
+            // Leave the seats held and try again on the next tick.
+            holdTimers.schedule(holdId, now + 1);
+        }
+    }
+}
+
+bool ReservationService::returnHeldSeats(const SeatHold& hold) {
+    if (!db->beginTransaction()) return false;
+
+    std::vector<Promotion> promotions;
+    int availableSeats;
+    if (!db->deleteSeatHold(hold.id) || !releaseSeats(hold.flightId, hold.seats, promotions, availableSeats)) {
+        db->rollbackTransaction();
+        return false;
+    }
+
+    if (!db->commitTransaction()) return false;
+
+    changes.publish(ChangeType::SeatsChanged, hold.flightId, 0, availableSeats);
+    applyPromotions(promotions, availableSeats);
+    return true;
+}
+
+void ReservationService::forgetHold(int holdId) {
+    auto hold = holds.find(holdId);
+    if (hold == holds.end()) return;
+    holdIdsByToken.erase(hold->second.token);
+    holds.erase(hold);
+}
+
+bool ReservationService::releaseSeats(int flightId, int seats, std::vector<Promotion>& promotions, int& availableSeats) {
+    // 1. Waitlisted passengers get the seats first, in FIFO order
+    auto waitlist = waitlists.find(flightId);
+    if (waitlist != waitlists.end()) {
+        for (const auto& entry : waitlist->second) {
+            if (seats == 0) break;
+            auto bookingIdOpt = db->addBooking(entry.flightId, entry.passengerName, entry.passengerEmail);
+            if (!bookingIdOpt || !db->deleteWaitlistEntry(entry.id)) return false;
+            promotions.emplace_back(entry, *bookingIdOpt);
+            --seats;
+        }
+    }
+
+    // 2. Whatever is left goes back on sale
+    if (seats > 0 && !db->updateFlightSeatCount(flightId, +seats)) return false;
+
+    // 3. Report the resulting seat count for the change feed
+    auto flightOpt = db->getFlightById(flightId);
+    if (!flightOpt) return false;
+    availableSeats = flightOpt->availableSeats;
+    return true;
+}
+
+void ReservationService::applyPromotions(const std::vector<Promotion>& promotions, int availableSeats) {
+    // Only touch the mirror and notify once the promotions are committed.
+    for (const auto& promotion : promotions) {
+        auto waitlist = waitlists.find(promotion.first.flightId);
+        waitlist->second.pop_front();
+        if (waitlist->second.empty()) waitlists.erase(waitlist);
+    }
+    for (const auto& promotion : promotions) {
+        changes.publish(ChangeType::BookingCreated, promotion.first.flightId, promotion.second, availableSeats);
+        for (const auto& subscriber : promotionSubscribers) {
+            subscriber.second(promotion.first, promotion.second);
+        }
+    }
 } 
\ No newline at end of file
@@ -2,7 +2,17 @@
 #define RESERVATION_SERVICE_H
 
 #include "../dal/IDatabaseManager.h"
+#include "ChangeFeed.h"
+#include "PricingEngine.h"
+#include "TimerWheel.h"
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
 #include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
 
 // Business Logic Layer: Handles the core application logic.
 // It is completely decoupled from the UI and the concrete database implementation.
@@ -14,15 +24,80 @@ public:
     // Admin services
     bool addNewFlight(const Flight& flight);
     std::vector<Flight> getAllFlights();
+    // Recomputes every fare from load factor, route demand and time to departure and
+    // publishes PriceChanged for each repriced flight.
+    // Returns the number of flights whose price changed.
+    std::optional<size_t> repriceAllFlights();
+
+    // Change feed of committed flight and booking events. Readers on any thread may poll
+    // the feed; changeSnapshot() is the resync point after a reader overflows. It is
+    // read-only and safe to call from reader threads: it reads committed state through
+    // a separate connection and leaves hold expiry to the service thread.
+    const ChangeFeed& changeFeed() const { return changes; }
+    std::optional<ChangeSnapshot> changeSnapshot();
+    // Committed state of one flight, read the same way; fills in FlightAdded and PriceChanged.
+    std::optional<Flight> committedFlight(int flightId);
+
+    // Reporting services, answered from the maintained aggregates in O(routes).
+    std::vector<RouteStats> getRouteReport();
+    std::vector<RouteStats> getDailyRouteReport();
+    // Recomputes the aggregates from scratch and reports any drift to std::cerr.
+    bool verifyRouteStats();
     
     // Passenger services
+    // Results leave totalSeats unpopulated (0), as passengers are never shown it.
     std::vector<Flight> findAvailableFlights(const std::string& origin, const std::string& destination);
+    // Arena overloads: the results, strings included, are allocated from `resource`.
+    std::pmr::vector<PmrFlight> findAvailableFlights(const std::string& origin, const std::string& destination, std::pmr::memory_resource* resource);
     std::optional<int> bookFlight(int flightId, const std::string& passengerName, const std::string& passengerEmail);
     bool cancelBooking(int bookingId);
     std::vector<Booking> findMyBookings(const std::string& passengerEmail);
+    std::pmr::vector<PmrBooking> findMyBookings(const std::string& passengerEmail, std::pmr::memory_resource* resource);
+
+    // Waitlist services
+    // A cancellation on a full flight hands its seat to the head of the waitlist in the
+    // same transaction; subscribers are told about the new booking once it is committed.
+    using PromotionCallback = std::function<void(const WaitlistEntry& entry, int bookingId)>;
+    std::optional<int> joinWaitlist(int flightId, const std::string& passengerName, const std::string& passengerEmail);
+    bool leaveWaitlist(int entryId);
+    int subscribeToPromotions(PromotionCallback callback);
+    void unsubscribeFromPromotions(int subscriptionId);
+
+    // Seat hold services
+    // A hold takes seats out of availability at once and returns a token; confirmHold turns
+    // it into bookings (unused seats are released), otherwise it lapses after `ttl`.
+    std::optional<std::string> holdSeats(int flightId, int seats, std::chrono::seconds ttl);
+    std::optional<std::vector<int>> confirmHold(const std::string& holdToken, const std::vector<Passenger>& passengers);
+    bool releaseHold(const std::string& holdToken);
+    // Runs at the start of every seat-related call; a host may also call it on a timer.
+    void releaseExpiredHolds();
 
 private:
+    // A waitlisted passenger and the booking they were promoted to.
+    using Promotion = std::pair<WaitlistEntry, int>;
+
     std::unique_ptr<IDatabaseManager> db;
+    PricingEngine pricing;
+    ChangeFeed changes;
+
+    // In-memory mirror of the Waitlist table, one FIFO queue per flight.
+    std::unordered_map<int, std::deque<WaitlistEntry>> waitlists;
+    std::map<int, PromotionCallback> promotionSubscribers;
+    int nextSubscriptionId = 1;
+
+    // Live holds keyed by ID, with their expiry timers ticking in Unix seconds.
+    std::unordered_map<int, SeatHold> holds;
+    std::unordered_map<std::string, int> holdIdsByToken;
+    TimerWheel holdTimers;
+    // Tokens are the only credential for a hold, so each is drawn straight from the OS source.
+    std::random_device tokenSource;
+
+    // Gives freed seats to the waitlist first; runs inside the caller's transaction.
+    bool releaseSeats(int flightId, int seats, std::vector<Promotion>& promotions, int& availableSeats);
+    // Updates the waitlist mirror and notifies subscribers; runs after the commit.
+    void applyPromotions(const std::vector<Promotion>& promotions, int availableSeats);
+    bool returnHeldSeats(const SeatHold& hold);
+    void forgetHold(int holdId);
 };
 
 #endif // RESERVATION_SERVICE_H 
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel(long long startTick) : currentTick(startTick) {}
+
+TimerWheel::Slot& TimerWheel::slotFor(long long expiry, bool allowNow) {
+    // Timers beyond the top level wait in its farthest slot and are re-placed when it cascades.
+    const long long maxDelta = (1LL << (kSlotBits * kLevels)) - 1;
+    long long delta = expiry - currentTick;
+    const long long minDelta = allowNow ? 0 : 1;
+    if (delta < minDelta) delta = minDelta;
+    if (delta > maxDelta) delta = maxDelta;
+    long long due = currentTick + delta;
+
+    int level = 0;
+    while (level < kLevels - 1 && delta >= (1LL << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+    return slots[level][(due >> (kSlotBits * level)) & (kSlots - 1)];
+}
+
+void TimerWheel::schedule(int timerId, long long expiryTick) {
+    cancel(timerId);
+    Slot& slot = slotFor(expiryTick);
+    slot.push_back(Timer{timerId, expiryTick});
+    index[timerId] = {&slot, std::prev(slot.end())};
+}
+
+bool TimerWheel::cancel(int timerId) {
+    auto it = index.find(timerId);
+    if (it == index.end()) return false;
+    it->second.first->erase(it->second.second);
+    index.erase(it);
+    return true;
+}
+
+std::vector<int> TimerWheel::advance(long long nowTick) {
+    std::vector<int> expired;
+    while (currentTick < nowTick) {
+        // Nothing to fire; skip the idle ticks in one step.
+        if (index.empty()) {
+            currentTick = nowTick;
+            break;
+        }
+        tick(expired);
+    }
+    return expired;
+}
+
+void TimerWheel::tick(std::vector<int>& expired) {
+    ++currentTick;
+
+    // 1. At each level boundary, move the timers of the slot now in range down a level
+    for (int level = 1; level < kLevels; ++level) {
+        if ((currentTick & ((1LL << (kSlotBits * level)) - 1)) != 0) break;
+        Slot& slot = slots[level][(currentTick >> (kSlotBits * level)) & (kSlots - 1)];
+        while (!slot.empty()) {
+            auto timer = slot.begin();
+            Slot& target = slotFor(timer->expiry, true);
+            target.splice(target.end(), slot, timer);
+            index[timer->id].first = &target;
+        }
+    }
+
+    // 2. Fire everything in the current level-0 slot
+    Slot& due = slots[0][currentTick & (kSlots - 1)];
+    for (const auto& timer : due) {
+        expired.push_back(timer.id);
+        index.erase(timer.id);
+    }
+    due.clear();
+} 
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Hierarchical timer wheel. Four levels of 64 slots cover about 194 days of ticks;
+// schedule, cancel and each tick are O(1), with timers cascading down a level as
+// their expiry comes within range. Ticks are plain integers chosen by the caller.
+class TimerWheel {
+public:
+    explicit TimerWheel(long long startTick);
+
+    // Timers that are already due fire on the next tick.
+    void schedule(int timerId, long long expiryTick);
+    bool cancel(int timerId);
+    // Moves the wheel forward to `nowTick` and returns the timers that expired on the way.
+    std::vector<int> advance(long long nowTick);
+    size_t size() const { return index.size(); }
+
+private:
+    static const int kLevels = 4;
+    static const int kSlotBits = 6;
+    static const int kSlots = 1 << kSlotBits;
+
+    struct Timer {
+        int id;
+        long long expiry;
+    };
+    using Slot = std::list<Timer>;
+
+    Slot slots[kLevels][kSlots];
+    std::unordered_map<int, std::pair<Slot*, Slot::iterator>> index;
+    long long currentTick;
+
+    // `allowNow` lets a timer due on the current tick land in the slot about to fire;
+    // only tick() may pass it, between advancing currentTick and firing that slot.
+    Slot& slotFor(long long expiry, bool allowNow = false);
+    void tick(std::vector<int>& expired);
+};
+
+#endif // TIMER_WHEEL_H 
\ No newline at end of file
@@ -1,7 +1,10 @@
 #ifndef MODELS_H
 #define MODELS_H
 
+#include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <vector>
 
 // Plain data structure for a Flight.
 struct Flight {
@@ -28,4 +31,144 @@ struct Booking {
     std::string departureTime;
 };
 
+// Allocator-aware counterparts of Flight and Booking. Every string lives in the
+// memory resource of the containing std::pmr::vector, so a whole result set can
+// be served from one arena and released at once.
+struct PmrFlight {
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    int id = 0;
+    std::pmr::string flightNumber;
+    std::pmr::string origin;
+    std::pmr::string destination;
+    std::pmr::string departureTime;
+    int totalSeats = 0;
+    int availableSeats = 0;
+    double price = 0.0;
+
+    PmrFlight() = default;
+    explicit PmrFlight(const allocator_type& alloc)
+        : flightNumber(alloc), origin(alloc), destination(alloc), departureTime(alloc) {}
+    PmrFlight(const PmrFlight& other, const allocator_type& alloc)
+        : id(other.id), flightNumber(other.flightNumber, alloc), origin(other.origin, alloc),
+          destination(other.destination, alloc), departureTime(other.departureTime, alloc),
+          totalSeats(other.totalSeats), availableSeats(other.availableSeats), price(other.price) {}
+    PmrFlight(PmrFlight&& other, const allocator_type& alloc)
+        : id(other.id), flightNumber(std::move(other.flightNumber), alloc), origin(std::move(other.origin), alloc),
+          destination(std::move(other.destination), alloc), departureTime(std::move(other.departureTime), alloc),
+          totalSeats(other.totalSeats), availableSeats(other.availableSeats), price(other.price) {}
+    PmrFlight(const PmrFlight&) = default;
+    PmrFlight(PmrFlight&&) = default;
+    PmrFlight& operator=(const PmrFlight&) = default;
+    PmrFlight& operator=(PmrFlight&&) = default;
+};
+
+struct PmrBooking {
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    int id = 0;
+    int flightId = 0;
+    std::pmr::string passengerName;
+    std::pmr::string passengerEmail;
+    std::pmr::string flightNumber;
+    std::pmr::string origin;
+    std::pmr::string destination;
+    std::pmr::string departureTime;
+
+    PmrBooking() = default;
+    explicit PmrBooking(const allocator_type& alloc)
+        : passengerName(alloc), passengerEmail(alloc), flightNumber(alloc),
+          origin(alloc), destination(alloc), departureTime(alloc) {}
+    PmrBooking(const PmrBooking& other, const allocator_type& alloc)
+        : id(other.id), flightId(other.flightId), passengerName(other.passengerName, alloc),
+          passengerEmail(other.passengerEmail, alloc), flightNumber(other.flightNumber, alloc),
+          origin(other.origin, alloc), destination(other.destination, alloc), departureTime(other.departureTime, alloc) {}
+    PmrBooking(PmrBooking&& other, const allocator_type& alloc)
+        : id(other.id), flightId(other.flightId), passengerName(std::move(other.passengerName), alloc),
+          passengerEmail(std::move(other.passengerEmail), alloc), flightNumber(std::move(other.flightNumber), alloc),
+          origin(std::move(other.origin), alloc), destination(std::move(other.destination), alloc),
+          departureTime(std::move(other.departureTime), alloc) {}
+    PmrBooking(const PmrBooking&) = default;
+    PmrBooking(PmrBooking&&) = default;
+    PmrBooking& operator=(const PmrBooking&) = default;
+    PmrBooking& operator=(PmrBooking&&) = default;
+};
+
+// A passenger queued for a seat on a full flight. Entries are served in ID order.
+struct WaitlistEntry {
+    int id;
+    int flightId;
+    std::string passengerName;
+    std::string passengerEmail;
+};
+
+// Seats taken out of availability for a limited time while a passenger checks out.
+struct SeatHold {
+    int id;
+    std::string token;
+    int flightId;
+    int seats;
+    long long expiresAt; // Unix time, in seconds
+};
+
+// Passenger details for turning a held seat into a booking.
+struct Passenger {
+    std::string name;
+    std::string email;
+};
+
+// Aggregated sales figures for a route, optionally for a single departure day.
+struct RouteStats {
+    std::string origin;
+    std::string destination;
+    std::string departureDay; // YYYY-MM-DD, empty when rolled up over all days
+    int flights;
+    int seatsOffered;
+    int seatsSold;
+    double revenue;
+    int bookings;
+    int cancellations;
+};
+
+// Kinds of committed change published on the change feed.
+enum class ChangeType : uint8_t {
+    FlightAdded,
+    SeatsChanged,
+    BookingCreated,
+    BookingCancelled,
+    PriceChanged
+};
+
+// One committed change. `availableSeats` is the flight's absolute count after the change,
+// so applying an event twice gives the same result; `bookingId` is 0 for flight events.
+struct ChangeEvent {
+    uint64_t sequence;
+    ChangeType type;
+    int flightId;
+    int bookingId;
+    int availableSeats;
+};
+
+// Flight state together with the last change sequence it reflects, for feed resyncs.
+struct ChangeSnapshot {
+    uint64_t sequence;
+    std::vector<Flight> flights;
+};
+
+// Column-oriented view of the schedule used by the repricing engine.
+// Each vector holds one column, indexed by the same row position, so the
+// fare rules can run as tight loops over contiguous arrays.
+struct FlightPricingColumns {
+    std::vector<int> ids;
+    std::vector<int> routeIndex;          // Dense index of (Origin, Destination)
+    std::vector<int> totalSeats;
+    std::vector<int> availableSeats;
+    std::vector<double> hoursToDeparture; // Negative once the flight has departed
+    std::vector<double> baseFares;
+    std::vector<double> prices;
+    int routeCount = 0;
+
+    size_t size() const { return ids.size(); }
+};
+
 #endif // MODELS_H 
\ No newline at end of file
@@ -15,17 +15,43 @@ public:
     virtual void initialize() = 0;
 
     // Flight Management
-    virtual bool addFlight(const Flight& flight) = 0;
+    virtual std::optional<int> addFlight(const Flight& flight) = 0;
+    // Search results leave totalSeats unpopulated (0); use getFlightById() for it.
     virtual std::vector<Flight> searchFlights(const std::string& origin, const std::string& destination) = 0;
+    virtual std::pmr::vector<PmrFlight> searchFlights(const std::string& origin, const std::string& destination, std::pmr::memory_resource* resource) = 0;
     virtual std::optional<Flight> getFlightById(int flightId) = 0;
     virtual std::vector<Flight> getAllFlights() = 0;
+    // Committed state only, read without the caller's transaction; safe from any thread.
+    virtual std::optional<std::vector<Flight>> getCommittedFlights() = 0;
+    virtual std::optional<Flight> getCommittedFlight(int flightId) = 0;
     virtual bool updateFlightSeatCount(int flightId, int change) = 0;
 
+    // Pricing
+    virtual std::optional<FlightPricingColumns> loadPricingColumns() = 0;
+    virtual bool updateFlightPrices(const std::vector<int>& flightIds, const std::vector<double>& prices) = 0;
+
     // Booking Management
     virtual std::optional<int> addBooking(int flightId, const std::string& passengerName, const std::string& passengerEmail) = 0;
     virtual std::optional<Booking> getBookingById(int bookingId) = 0;
     virtual bool deleteBooking(int bookingId) = 0;
     virtual std::vector<Booking> getBookingsForPassenger(const std::string& passengerEmail) = 0;
+    virtual std::pmr::vector<PmrBooking> getBookingsForPassenger(const std::string& passengerEmail, std::pmr::memory_resource* resource) = 0;
+
+    // Waitlist Management
+    virtual std::optional<int> addWaitlistEntry(int flightId, const std::string& passengerName, const std::string& passengerEmail) = 0;
+    virtual bool deleteWaitlistEntry(int entryId) = 0;
+    virtual std::vector<WaitlistEntry> getWaitlistEntries() = 0;
+
+    // Seat Hold Management
+    virtual std::optional<int> addSeatHold(const SeatHold& hold) = 0;
+    virtual bool deleteSeatHold(int holdId) = 0;
+    virtual std::vector<SeatHold> getSeatHolds() = 0;
+
+    // Reporting
+    // Aggregates per route and departure day, maintained alongside every flight/booking change.
+    virtual std::vector<RouteStats> getRouteDailyStats() = 0;
+    // The same aggregates recomputed from the base tables, for verification.
+    virtual std::vector<RouteStats> recomputeRouteDailyStats() = 0;
 
     // Transaction Management
     virtual bool beginTransaction() = 0;
@@ -1,16 +1,138 @@
 #include "SqliteDatabaseManager.h"
+#include "SqliteRowMapping.h"
 #include <iostream>
 #include <stdexcept>
+#include <unordered_map>
+#include <cstdio>
 
-SqliteDatabaseManager::SqliteDatabaseManager(const std::string& db_name) : db(nullptr), dbName(db_name) {
-    if (sqlite3_open(dbName.c_str(), &db)) {
+// Pause between backup steps so queued writers can take the lock.
+static const std::chrono::milliseconds kSnapshotStepPause(5);
+
+// How long either connection waits on the other's lock: a commit on a committed read
+// in progress, or a committed read on a commit in progress.
+static const int kBusyTimeoutMs = 5000;
+
+// Route/day aggregates recomputed from the base tables. Used both to backfill
+// RouteDailyStats and to verify the trigger-maintained copy.
+static const char* kRecomputeRouteStatsSql =
+    "SELECT f.Origin AS Origin, f.Destination AS Destination, substr(f.DepartureTime, 1, 10) AS DepartureDay, "
+    "COUNT(*) AS Flights, SUM(f.TotalSeats) AS SeatsOffered, "
+    "COALESCE(SUM(b.Sold), 0) AS SeatsSold, COALESCE(SUM(b.Revenue), 0.0) AS Revenue "
+    "FROM Flights f LEFT JOIN ("
+    "SELECT FlightID, COUNT(*) AS Sold, SUM(Price) AS Revenue FROM Bookings GROUP BY FlightID"
+    ") b ON b.FlightID = f.ID "
+    "GROUP BY f.Origin, f.Destination, DepartureDay";
+
+// Column projections. Each query selects exactly the columns of its mapper.
+static constexpr auto kFlightRow = makeRowMapper(
+    column("ID", &Flight::id),
+    column("FlightNumber", &Flight::flightNumber),
+    column("Origin", &Flight::origin),
+    column("Destination", &Flight::destination),
+    column("DepartureTime", &Flight::departureTime),
+    column("TotalSeats", &Flight::totalSeats),
+    column("AvailableSeats", &Flight::availableSeats),
+    column("Price", &Flight::price));
+
+// Search results are only ever shown to passengers, who never see TotalSeats.
+static constexpr auto kFlightSearchRow = makeRowMapper(
+    column("ID", &Flight::id),
+    column("FlightNumber", &Flight::flightNumber),
+    column("Origin", &Flight::origin),
+    column("Destination", &Flight::destination),
+    column("DepartureTime", &Flight::departureTime),
+    column("AvailableSeats", &Flight::availableSeats),
+    column("Price", &Flight::price));
+
+static constexpr auto kPmrFlightSearchRow = makeRowMapper(
+    column("ID", &PmrFlight::id),
+    column("FlightNumber", &PmrFlight::flightNumber),
+    column("Origin", &PmrFlight::origin),
+    column("Destination", &PmrFlight::destination),
+    column("DepartureTime", &PmrFlight::departureTime),
+    column("AvailableSeats", &PmrFlight::availableSeats),
+    column("Price", &PmrFlight::price));
+
+static constexpr auto kBookingRow = makeRowMapper(
+    column("b.ID", &Booking::id),
+    column("b.FlightID", &Booking::flightId),
+    column("b.PassengerName", &Booking::passengerName),
+    column("b.PassengerEmail", &Booking::passengerEmail),
+    column("f.FlightNumber", &Booking::flightNumber),
+    column("f.Origin", &Booking::origin),
+    column("f.Destination", &Booking::destination),
+    column("f.DepartureTime", &Booking::departureTime));
+
+static constexpr auto kPmrBookingRow = makeRowMapper(
+    column("b.ID", &PmrBooking::id),
+    column("b.FlightID", &PmrBooking::flightId),
+    column("b.PassengerName", &PmrBooking::passengerName),
+    column("b.PassengerEmail", &PmrBooking::passengerEmail),
+    column("f.FlightNumber", &PmrBooking::flightNumber),
+    column("f.Origin", &PmrBooking::origin),
+    column("f.Destination", &PmrBooking::destination),
+    column("f.DepartureTime", &PmrBooking::departureTime));
+
+static constexpr auto kWaitlistRow = makeRowMapper(
+    column("ID", &WaitlistEntry::id),
+    column("FlightID", &WaitlistEntry::flightId),
+    column("PassengerName", &WaitlistEntry::passengerName),
+    column("PassengerEmail", &WaitlistEntry::passengerEmail));
+
+static constexpr auto kSeatHoldRow = makeRowMapper(
+    column("ID", &SeatHold::id),
+    column("Token", &SeatHold::token),
+    column("FlightID", &SeatHold::flightId),
+    column("Seats", &SeatHold::seats),
+    column("ExpiresAt", &SeatHold::expiresAt));
+
+static constexpr auto kRouteStatsRow = makeRowMapper(
+    column("Origin", &RouteStats::origin),
+    column("Destination", &RouteStats::destination),
+    column("DepartureDay", &RouteStats::departureDay),
+    column("Flights", &RouteStats::flights),
+    column("SeatsOffered", &RouteStats::seatsOffered),
+    column("SeatsSold", &RouteStats::seatsSold),
+    column("Revenue", &RouteStats::revenue),
+    column("Bookings", &RouteStats::bookings),
+    column("Cancellations", &RouteStats::cancellations));
+
+// Matches the column order of kRecomputeRouteStatsSql.
+static constexpr auto kRecomputedRouteStatsRow = makeRowMapper(
+    column("Origin", &RouteStats::origin),
+    column("Destination", &RouteStats::destination),
+    column("DepartureDay", &RouteStats::departureDay),
+    column("Flights", &RouteStats::flights),
+    column("SeatsOffered", &RouteStats::seatsOffered),
+    column("SeatsSold", &RouteStats::seatsSold),
+    column("Revenue", &RouteStats::revenue));
+
+SqliteDatabaseManager::SqliteDatabaseManager(const std::string& db_name, bool readOnly) : db(nullptr), dbName(db_name) {
+    // Full mutex mode: the snapshot thread shares this connection with the caller.
+    int flags = readOnly ? SQLITE_OPEN_READONLY : (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    if (sqlite3_open_v2(dbName.c_str(), &db, flags | SQLITE_OPEN_FULLMUTEX, nullptr)) {
         std::string errorMsg = "Can't open database: " + std::string(sqlite3_errmsg(db));
         sqlite3_close(db);
         throw std::runtime_error(errorMsg);
     }
+    sqlite3_busy_timeout(db, kBusyTimeoutMs);
 }
 
 SqliteDatabaseManager::~SqliteDatabaseManager() {
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        snapshotStopping = true;
+    }
+    snapshotCv.notify_all();
+    if (snapshotThread.joinable()) {
+        snapshotThread.join();
+    }
+    for (auto& job : snapshotQueue) {
+        job.done.set_value(false);
+    }
+    if (readDb) {
+        sqlite3_close(readDb);
+    }
     if (db) {
         sqlite3_close(db);
     }
@@ -27,6 +149,28 @@ bool SqliteDatabaseManager::execute(const std::string& sql) {
     return true;
 }
 
+bool SqliteDatabaseManager::hasColumn(const std::string& table, const std::string& column) {
+    sqlite3_stmt* stmt;
+    std::string sql = "PRAGMA table_info(" + table + ");";
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return false;
+    bool found = false;
+    while (!found && sqlite3_step(stmt) == SQLITE_ROW) {
+        found = (column == (const char*)sqlite3_column_text(stmt, 1));
+    }
+    sqlite3_finalize(stmt);
+    return found;
+}
+
+bool SqliteDatabaseManager::hasTable(const std::string& table) {
+    sqlite3_stmt* stmt;
+    const char* sql = "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?;";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return false;
+    sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_STATIC);
+    bool found = (sqlite3_step(stmt) == SQLITE_ROW);
+    sqlite3_finalize(stmt);
+    return found;
+}
+
 void SqliteDatabaseManager::initialize() {
     std::string createFlightsTable =
         "CREATE TABLE IF NOT EXISTS Flights ("
@@ -37,7 +181,8 @@ void SqliteDatabaseManager::initialize() {
         "DepartureTime TEXT NOT NULL, "
         "TotalSeats INTEGER NOT NULL, "
         "AvailableSeats INTEGER NOT NULL, "
-        "Price REAL NOT NULL);";
+        "Price REAL NOT NULL, "
+        "BaseFare REAL NOT NULL DEFAULT 0);";
 
     std::string createBookingsTable =
         "CREATE TABLE IF NOT EXISTS Bookings ("
@@ -45,18 +190,122 @@ void SqliteDatabaseManager::initialize() {
         "FlightID INTEGER NOT NULL, "
         "PassengerName TEXT NOT NULL, "
         "PassengerEmail TEXT NOT NULL, "
+        "Price REAL NOT NULL DEFAULT 0, "
+        "FOREIGN KEY(FlightID) REFERENCES Flights(ID));";
+
+    std::string createWaitlistTable =
+        "CREATE TABLE IF NOT EXISTS Waitlist ("
+        "ID INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "FlightID INTEGER NOT NULL, "
+        "PassengerName TEXT NOT NULL, "
+        "PassengerEmail TEXT NOT NULL, "
+        "FOREIGN KEY(FlightID) REFERENCES Flights(ID));";
+
+    std::string createSeatHoldsTable =
+        "CREATE TABLE IF NOT EXISTS SeatHolds ("
+        "ID INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "Token TEXT NOT NULL UNIQUE, "
+        "FlightID INTEGER NOT NULL, "
+        "Seats INTEGER NOT NULL, "
+        "ExpiresAt INTEGER NOT NULL, "
         "FOREIGN KEY(FlightID) REFERENCES Flights(ID));";
 
-    if (!execute(createFlightsTable) || !execute(createBookingsTable)) {
+    if (!execute(createFlightsTable) || !execute(createBookingsTable) ||
+        !execute(createWaitlistTable) || !execute(createSeatHoldsTable)) {
         throw std::runtime_error("Failed to create database tables.");
     }
+
+    // Each migration adds its column and fills it in one transaction, so a crash
+    // part way through never leaves the column present but unpopulated.
+
+    // Bookings made before fares were recorded are valued at the flight's current price.
+    if (!hasColumn("Bookings", "Price")) {
+        if (!beginTransaction() ||
+            !execute("ALTER TABLE Bookings ADD COLUMN Price REAL NOT NULL DEFAULT 0;") ||
+            !execute("UPDATE Bookings SET Price = (SELECT f.Price FROM Flights f WHERE f.ID = Bookings.FlightID);") ||
+            !commitTransaction()) {
+            rollbackTransaction();
+            throw std::runtime_error("Failed to migrate Bookings table.");
+        }
+    }
+
+    // Databases created before dynamic pricing have no BaseFare; seed it from the current price.
+    if (!hasColumn("Flights", "BaseFare")) {
+        if (!beginTransaction() ||
+            !execute("ALTER TABLE Flights ADD COLUMN BaseFare REAL NOT NULL DEFAULT 0;") ||
+            !execute("UPDATE Flights SET BaseFare = Price;") ||
+            !commitTransaction()) {
+            rollbackTransaction();
+            throw std::runtime_error("Failed to migrate Flights table.");
+        }
+    }
+
+    initializeRouteStats();
 }
 
-bool SqliteDatabaseManager::addFlight(const Flight& flight) {
+void SqliteDatabaseManager::initializeRouteStats() {
+    // Per route and departure day aggregates, kept current by triggers so they are
+    // updated in the same transaction as the flight or booking change.
+    std::string createStatsTable =
+        "CREATE TABLE IF NOT EXISTS RouteDailyStats ("
+        "Origin TEXT NOT NULL, "
+        "Destination TEXT NOT NULL, "
+        "DepartureDay TEXT NOT NULL, "
+        "Flights INTEGER NOT NULL DEFAULT 0, "
+        "SeatsOffered INTEGER NOT NULL DEFAULT 0, "
+        "SeatsSold INTEGER NOT NULL DEFAULT 0, "
+        "Revenue REAL NOT NULL DEFAULT 0, "
+        "Bookings INTEGER NOT NULL DEFAULT 0, "
+        "Cancellations INTEGER NOT NULL DEFAULT 0, "
+        "PRIMARY KEY(Origin, Destination, DepartureDay));";
+
+    std::string flightInsertTrigger =
+        "CREATE TRIGGER IF NOT EXISTS RouteStatsFlightInsert AFTER INSERT ON Flights BEGIN "
+        "INSERT OR IGNORE INTO RouteDailyStats (Origin, Destination, DepartureDay) "
+        "VALUES (NEW.Origin, NEW.Destination, substr(NEW.DepartureTime, 1, 10)); "
+        "UPDATE RouteDailyStats SET Flights = Flights + 1, SeatsOffered = SeatsOffered + NEW.TotalSeats "
+        "WHERE Origin = NEW.Origin AND Destination = NEW.Destination AND DepartureDay = substr(NEW.DepartureTime, 1, 10); "
+        "END;";
+
+    std::string bookingInsertTrigger =
+        "CREATE TRIGGER IF NOT EXISTS RouteStatsBookingInsert AFTER INSERT ON Bookings BEGIN "
+        "UPDATE RouteDailyStats SET SeatsSold = SeatsSold + 1, Revenue = Revenue + NEW.Price, Bookings = Bookings + 1 "
+        "WHERE (Origin, Destination, DepartureDay) = "
+        "(SELECT Origin, Destination, substr(DepartureTime, 1, 10) FROM Flights WHERE ID = NEW.FlightID); "
+        "END;";
+
+    std::string bookingDeleteTrigger =
+        "CREATE TRIGGER IF NOT EXISTS RouteStatsBookingDelete AFTER DELETE ON Bookings BEGIN "
+        "UPDATE RouteDailyStats SET SeatsSold = SeatsSold - 1, Revenue = Revenue - OLD.Price, Cancellations = Cancellations + 1 "
+        "WHERE (Origin, Destination, DepartureDay) = "
+        "(SELECT Origin, Destination, substr(DepartureTime, 1, 10) FROM Flights WHERE ID = OLD.FlightID); "
+        "END;";
+
+    // Existing databases start from a full recompute; past cancellations are unknown.
+    std::string populate =
+        "INSERT INTO RouteDailyStats (Origin, Destination, DepartureDay, Flights, SeatsOffered, SeatsSold, Revenue, Bookings) "
+        "SELECT Origin, Destination, DepartureDay, Flights, SeatsOffered, SeatsSold, Revenue, SeatsSold "
+        "FROM (" + std::string(kRecomputeRouteStatsSql) + ");";
+
+    // The table, its triggers and the backfill commit together. Otherwise a crash after
+    // the CREATE would leave an empty table that is never backfilled on the next start.
+    if (!beginTransaction()) {
+        throw std::runtime_error("Failed to create route statistics.");
+    }
+    bool backfill = !hasTable("RouteDailyStats");
+    if (!execute(createStatsTable) || !execute(flightInsertTrigger) ||
+        !execute(bookingInsertTrigger) || !execute(bookingDeleteTrigger) ||
+        (backfill && !execute(populate)) || !commitTransaction()) {
+        rollbackTransaction();
+        throw std::runtime_error("Failed to create route statistics.");
+    }
+}
+
+std::optional<int> SqliteDatabaseManager::addFlight(const Flight& flight) {
     sqlite3_stmt* stmt;
-    const char* sql = "INSERT INTO Flights (FlightNumber, Origin, Destination, DepartureTime, TotalSeats, AvailableSeats, Price) VALUES (?, ?, ?, ?, ?, ?, ?);";
+    const char* sql = "INSERT INTO Flights (FlightNumber, Origin, Destination, DepartureTime, TotalSeats, AvailableSeats, Price, BaseFare) VALUES (?, ?, ?, ?, ?, ?, ?, ?);";
     
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return false;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return std::nullopt;
 
     sqlite3_bind_text(stmt, 1, flight.flightNumber.c_str(), -1, SQLITE_STATIC);
     sqlite3_bind_text(stmt, 2, flight.origin.c_str(), -1, SQLITE_STATIC);
@@ -65,79 +314,78 @@ bool SqliteDatabaseManager::addFlight(const Flight& flight) {
     sqlite3_bind_int(stmt, 5, flight.totalSeats);
     sqlite3_bind_int(stmt, 6, flight.availableSeats);
     sqlite3_bind_double(stmt, 7, flight.price);
+    sqlite3_bind_double(stmt, 8, flight.price);
 
-    bool success = (sqlite3_step(stmt) == SQLITE_DONE);
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        sqlite3_finalize(stmt);
+        return std::nullopt;
+    }
+    int flightId = sqlite3_last_insert_rowid(db);
     sqlite3_finalize(stmt);
-    return success;
+    return flightId;
 }
 
 std::vector<Flight> SqliteDatabaseManager::searchFlights(const std::string& origin, const std::string& destination) {
-    std::vector<Flight> flights;
-    sqlite3_stmt* stmt;
-    const char* sql = "SELECT * FROM Flights WHERE Origin = ? AND Destination = ? AND AvailableSeats > 0;";
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return flights;
-    sqlite3_bind_text(stmt, 1, origin.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, destination.c_str(), -1, SQLITE_STATIC);
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        flights.emplace_back(Flight{
-            sqlite3_column_int(stmt, 0),
-            (const char*)sqlite3_column_text(stmt, 1),
-            (const char*)sqlite3_column_text(stmt, 2),
-            (const char*)sqlite3_column_text(stmt, 3),
-            (const char*)sqlite3_column_text(stmt, 4),
-            sqlite3_column_int(stmt, 5),
-            sqlite3_column_int(stmt, 6),
-            sqlite3_column_double(stmt, 7)
-        });
-    }
-    sqlite3_finalize(stmt);
+    static const std::string sql = "SELECT " + kFlightSearchRow.columnList() + " FROM Flights WHERE Origin = ? AND Destination = ? AND AvailableSeats > 0;";
+    return queryRows(db, sql, kFlightSearchRow, origin, destination);
+}
+
+std::pmr::vector<PmrFlight> SqliteDatabaseManager::searchFlights(const std::string& origin, const std::string& destination, std::pmr::memory_resource* resource) {
+    static const std::string sql = "SELECT " + kPmrFlightSearchRow.columnList() + " FROM Flights WHERE Origin = ? AND Destination = ? AND AvailableSeats > 0;";
+    std::pmr::vector<PmrFlight> flights(resource);
+    appendRows(db, sql, kPmrFlightSearchRow, flights, origin, destination);
     return flights;
 }
 
 std::optional<Flight> SqliteDatabaseManager::getFlightById(int flightId) {
-    sqlite3_stmt* stmt;
-    const char* sql = "SELECT * FROM Flights WHERE ID = ?;";
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return std::nullopt;
-    sqlite3_bind_int(stmt, 1, flightId);
-    if (sqlite3_step(stmt) == SQLITE_ROW) {
-        Flight flight = {
-            sqlite3_column_int(stmt, 0),
-            (const char*)sqlite3_column_text(stmt, 1),
-            (const char*)sqlite3_column_text(stmt, 2),
-            (const char*)sqlite3_column_text(stmt, 3),
-            (const char*)sqlite3_column_text(stmt, 4),
-            sqlite3_column_int(stmt, 5),
-            sqlite3_column_int(stmt, 6),
-            sqlite3_column_double(stmt, 7)
-        };
-        sqlite3_finalize(stmt);
-        return flight;
-    }
-    sqlite3_finalize(stmt);
-    return std::nullopt;
+    static const std::string sql = "SELECT " + kFlightRow.columnList() + " FROM Flights WHERE ID = ?;";
+    return queryRow(db, sql, kFlightRow, flightId);
 }
 
 std::vector<Flight> SqliteDatabaseManager::getAllFlights() {
-    std::vector<Flight> flights;
+    static const std::string sql = "SELECT " + kFlightRow.columnList() + " FROM Flights;";
+    return queryRows(db, sql, kFlightRow);
+}
+
+// Caller holds readMutex.
+bool SqliteDatabaseManager::openReadConnection() {
+    if (readDb) return true;
+    if (sqlite3_open_v2(dbName.c_str(), &readDb, SQLITE_OPEN_READONLY | SQLITE_OPEN_FULLMUTEX, nullptr) != SQLITE_OK) {
+        std::cerr << "Read connection error: " << sqlite3_errmsg(readDb) << std::endl;
+        sqlite3_close(readDb);
+        readDb = nullptr;
+        return false;
+    }
+    sqlite3_busy_timeout(readDb, kBusyTimeoutMs);
+    return true;
+}
+
+std::optional<std::vector<Flight>> SqliteDatabaseManager::getCommittedFlights() {
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (!openReadConnection()) return std::nullopt;
+
+    // Stepped by hand rather than through queryRows, so a busy or failed read is
+    // reported instead of returning a partial schedule.
+    static const std::string sql = "SELECT " + kFlightRow.columnList() + " FROM Flights;";
     sqlite3_stmt* stmt;
-    const char* sql = "SELECT * FROM Flights;";
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return flights;
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        flights.emplace_back(Flight{
-            sqlite3_column_int(stmt, 0),
-            (const char*)sqlite3_column_text(stmt, 1),
-            (const char*)sqlite3_column_text(stmt, 2),
-            (const char*)sqlite3_column_text(stmt, 3),
-            (const char*)sqlite3_column_text(stmt, 4),
-            sqlite3_column_int(stmt, 5),
-            sqlite3_column_int(stmt, 6),
-            sqlite3_column_double(stmt, 7)
-        });
+    if (sqlite3_prepare_v2(readDb, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return std::nullopt;
+    std::vector<Flight> flights;
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        kFlightRow.readInto(stmt, flights.emplace_back());
     }
     sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE) return std::nullopt;
     return flights;
 }
 
+std::optional<Flight> SqliteDatabaseManager::getCommittedFlight(int flightId) {
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (!openReadConnection()) return std::nullopt;
+    static const std::string sql = "SELECT " + kFlightRow.columnList() + " FROM Flights WHERE ID = ?;";
+    return queryRow(readDb, sql, kFlightRow, flightId);
+}
+
 bool SqliteDatabaseManager::updateFlightSeatCount(int flightId, int change) {
     sqlite3_stmt* stmt;
     const char* sql = "UPDATE Flights SET AvailableSeats = AvailableSeats + ? WHERE ID = ?;";
@@ -149,9 +397,57 @@ bool SqliteDatabaseManager::updateFlightSeatCount(int flightId, int change) {
     return success;
 }
 
+std::optional<FlightPricingColumns> SqliteDatabaseManager::loadPricingColumns() {
+    FlightPricingColumns cols;
+    sqlite3_stmt* stmt;
+    // Time to departure is computed by SQLite; unparseable times count as departed.
+    const char* sql =
+        "SELECT ID, Origin, Destination, TotalSeats, AvailableSeats, "
+        "COALESCE((julianday(DepartureTime) - julianday('now', 'localtime')) * 24.0, -1.0), "
+        "BaseFare, Price FROM Flights;";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return std::nullopt;
+
+    std::unordered_map<std::string, int> routes;
+    std::string routeKey;
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        routeKey.assign((const char*)sqlite3_column_text(stmt, 1));
+        routeKey.push_back('\x1f');
+        routeKey.append((const char*)sqlite3_column_text(stmt, 2));
+        auto route = routes.emplace(routeKey, (int)routes.size()).first;
+
+        cols.ids.push_back(sqlite3_column_int(stmt, 0));
+        cols.routeIndex.push_back(route->second);
+        cols.totalSeats.push_back(sqlite3_column_int(stmt, 3));
+        cols.availableSeats.push_back(sqlite3_column_int(stmt, 4));
+        cols.hoursToDeparture.push_back(sqlite3_column_double(stmt, 5));
+        cols.baseFares.push_back(sqlite3_column_double(stmt, 6));
+        cols.prices.push_back(sqlite3_column_double(stmt, 7));
+    }
+    sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE) return std::nullopt;
+    cols.routeCount = (int)routes.size();
+    return cols;
+}
+
+bool SqliteDatabaseManager::updateFlightPrices(const std::vector<int>& flightIds, const std::vector<double>& prices) {
+    sqlite3_stmt* stmt;
+    const char* sql = "UPDATE Flights SET Price = ? WHERE ID = ?;";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return false;
+    bool success = true;
+    for (size_t i = 0; success && i < flightIds.size(); ++i) {
+        sqlite3_bind_double(stmt, 1, prices[i]);
+        sqlite3_bind_int(stmt, 2, flightIds[i]);
+        success = (sqlite3_step(stmt) == SQLITE_DONE);
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+    return success;
+}
+
 std::optional<int> SqliteDatabaseManager::addBooking(int flightId, const std::string& passengerName, const std::string& passengerEmail) {
     sqlite3_stmt* stmt;
-    const char* sql = "INSERT INTO Bookings (FlightID, PassengerName, PassengerEmail) VALUES (?, ?, ?);";
+    const char* sql = "INSERT INTO Bookings (FlightID, PassengerName, PassengerEmail, Price) VALUES (?, ?, ?, (SELECT Price FROM Flights WHERE ID = ?1));";
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return std::nullopt;
     
     sqlite3_bind_int(stmt, 1, flightId);
@@ -168,26 +464,8 @@ std::optional<int> SqliteDatabaseManager::addBooking(int flightId, const std::st
 }
 
 std::optional<Booking> SqliteDatabaseManager::getBookingById(int bookingId) {
-    sqlite3_stmt* stmt;
-    const char* sql = "SELECT b.ID, b.FlightID, b.PassengerName, b.PassengerEmail, f.FlightNumber, f.Origin, f.Destination, f.DepartureTime FROM Bookings b JOIN Flights f ON b.FlightID = f.ID WHERE b.ID = ?;";
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return std::nullopt;
-    sqlite3_bind_int(stmt, 1, bookingId);
-    if (sqlite3_step(stmt) == SQLITE_ROW) {
-        Booking booking = {
-            sqlite3_column_int(stmt, 0),
-            sqlite3_column_int(stmt, 1),
-            (const char*)sqlite3_column_text(stmt, 2),
-            (const char*)sqlite3_column_text(stmt, 3),
-            (const char*)sqlite3_column_text(stmt, 4),
-            (const char*)sqlite3_column_text(stmt, 5),
-            (const char*)sqlite3_column_text(stmt, 6),
-            (const char*)sqlite3_column_text(stmt, 7)
-        };
-        sqlite3_finalize(stmt);
-        return booking;
-    }
-    sqlite3_finalize(stmt);
-    return std::nullopt;
+    static const std::string sql = "SELECT " + kBookingRow.columnList() + " FROM Bookings b JOIN Flights f ON b.FlightID = f.ID WHERE b.ID = ?;";
+    return queryRow(db, sql, kBookingRow, bookingId);
 }
 
 bool SqliteDatabaseManager::deleteBooking(int bookingId) {
@@ -201,25 +479,93 @@ bool SqliteDatabaseManager::deleteBooking(int bookingId) {
 }
 
 std::vector<Booking> SqliteDatabaseManager::getBookingsForPassenger(const std::string& passengerEmail) {
-    std::vector<Booking> bookings;
+    static const std::string sql = "SELECT " + kBookingRow.columnList() + " FROM Bookings b JOIN Flights f ON b.FlightID = f.ID WHERE b.PassengerEmail = ?;";
+    return queryRows(db, sql, kBookingRow, passengerEmail);
+}
+
+std::pmr::vector<PmrBooking> SqliteDatabaseManager::getBookingsForPassenger(const std::string& passengerEmail, std::pmr::memory_resource* resource) {
+    static const std::string sql = "SELECT " + kPmrBookingRow.columnList() + " FROM Bookings b JOIN Flights f ON b.FlightID = f.ID WHERE b.PassengerEmail = ?;";
+    std::pmr::vector<PmrBooking> bookings(resource);
+    appendRows(db, sql, kPmrBookingRow, bookings, passengerEmail);
+    return bookings;
+}
+
+std::optional<int> SqliteDatabaseManager::addWaitlistEntry(int flightId, const std::string& passengerName, const std::string& passengerEmail) {
+    sqlite3_stmt* stmt;
+    const char* sql = "INSERT INTO Waitlist (FlightID, PassengerName, PassengerEmail) VALUES (?, ?, ?);";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return std::nullopt;
+
+    sqlite3_bind_int(stmt, 1, flightId);
+    sqlite3_bind_text(stmt, 2, passengerName.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, passengerEmail.c_str(), -1, SQLITE_STATIC);
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        sqlite3_finalize(stmt);
+        return std::nullopt;
+    }
+    int entryId = sqlite3_last_insert_rowid(db);
+    sqlite3_finalize(stmt);
+    return entryId;
+}
+
+bool SqliteDatabaseManager::deleteWaitlistEntry(int entryId) {
     sqlite3_stmt* stmt;
-    const char* sql = "SELECT b.ID, b.FlightID, b.PassengerName, b.PassengerEmail, f.FlightNumber, f.Origin, f.Destination, f.DepartureTime FROM Bookings b JOIN Flights f ON b.FlightID = f.ID WHERE b.PassengerEmail = ?;";
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return bookings;
-    sqlite3_bind_text(stmt, 1, passengerEmail.c_str(), -1, SQLITE_STATIC);
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        bookings.emplace_back(Booking{
-            sqlite3_column_int(stmt, 0),
-            sqlite3_column_int(stmt, 1),
-            (const char*)sqlite3_column_text(stmt, 2),
-            (const char*)sqlite3_column_text(stmt, 3),
-            (const char*)sqlite3_column_text(stmt, 4),
-            (const char*)sqlite3_column_text(stmt, 5),
-            (const char*)sqlite3_column_text(stmt, 6),
-            (const char*)sqlite3_column_text(stmt, 7)
-        });
+    const char* sql = "DELETE FROM Waitlist WHERE ID = ?;";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return false;
+    sqlite3_bind_int(stmt, 1, entryId);
+    bool success = (sqlite3_step(stmt) == SQLITE_DONE && sqlite3_changes(db) == 1);
+    sqlite3_finalize(stmt);
+    return success;
+}
+
+std::vector<WaitlistEntry> SqliteDatabaseManager::getWaitlistEntries() {
+    static const std::string sql = "SELECT " + kWaitlistRow.columnList() + " FROM Waitlist ORDER BY FlightID, ID;";
+    return queryRows(db, sql, kWaitlistRow);
+}
+
+std::optional<int> SqliteDatabaseManager::addSeatHold(const SeatHold& hold) {
+    sqlite3_stmt* stmt;
+    const char* sql = "INSERT INTO SeatHolds (Token, FlightID, Seats, ExpiresAt) VALUES (?, ?, ?, ?);";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return std::nullopt;
+    StatementBinder<std::string, int, int, long long>::bind(stmt, hold.token, hold.flightId, hold.seats, hold.expiresAt);
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        sqlite3_finalize(stmt);
+        return std::nullopt;
     }
+    int holdId = sqlite3_last_insert_rowid(db);
     sqlite3_finalize(stmt);
-    return bookings;
+    return holdId;
+}
+
+bool SqliteDatabaseManager::deleteSeatHold(int holdId) {
+    sqlite3_stmt* stmt;
+    const char* sql = "DELETE FROM SeatHolds WHERE ID = ?;";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return false;
+    sqlite3_bind_int(stmt, 1, holdId);
+    bool success = (sqlite3_step(stmt) == SQLITE_DONE && sqlite3_changes(db) == 1);
+    sqlite3_finalize(stmt);
+    return success;
+}
+
+std::vector<SeatHold> SqliteDatabaseManager::getSeatHolds() {
+    static const std::string sql = "SELECT " + kSeatHoldRow.columnList() + " FROM SeatHolds;";
+    return queryRows(db, sql, kSeatHoldRow);
+}
+
+std::vector<RouteStats> SqliteDatabaseManager::getRouteDailyStats() {
+    static const std::string sql = "SELECT " + kRouteStatsRow.columnList() + " FROM RouteDailyStats ORDER BY Origin, Destination, DepartureDay;";
+    return queryRows(db, sql, kRouteStatsRow);
+}
+
+std::vector<RouteStats> SqliteDatabaseManager::recomputeRouteDailyStats() {
+    static const std::string sql = std::string(kRecomputeRouteStatsSql) + " ORDER BY f.Origin, f.Destination, DepartureDay;";
+    auto stats = queryRows(db, sql, kRecomputedRouteStatsRow);
+    // Only net bookings survive in the base tables, so they are reported with no cancellations.
+    for (auto& s : stats) {
+        s.bookings = s.seatsSold;
+    }
+    return stats;
 }
 
 bool SqliteDatabaseManager::beginTransaction() {
@@ -232,4 +578,125 @@ bool SqliteDatabaseManager::commitTransaction() {
 
 bool SqliteDatabaseManager::rollbackTransaction() {
     return execute("ROLLBACK;");
+}
+
+void SqliteDatabaseManager::startPeriodicSnapshots(const std::string& path, std::chrono::seconds interval, int pagesPerStep) {
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        periodicSnapshots = true;
+        periodicPath = path;
+        periodicInterval = interval;
+        periodicPagesPerStep = pagesPerStep;
+        nextPeriodicSnapshot = std::chrono::steady_clock::now() + interval;
+        ensureSnapshotThread();
+    }
+    snapshotCv.notify_all();
+}
+
+void SqliteDatabaseManager::stopPeriodicSnapshots() {
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    periodicSnapshots = false;
+}
+
+std::future<bool> SqliteDatabaseManager::requestSnapshot(const std::string& path, int pagesPerStep) {
+    std::future<bool> result;
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        snapshotQueue.push_back(SnapshotJob{path, pagesPerStep, std::promise<bool>()});
+        result = snapshotQueue.back().done.get_future();
+        ensureSnapshotThread();
+    }
+    snapshotCv.notify_all();
+    return result;
+}
+
+std::unique_ptr<SqliteDatabaseManager> SqliteDatabaseManager::openSnapshot(const std::string& path) {
+    return std::make_unique<SqliteDatabaseManager>(path, true);
+}
+
+// Caller holds snapshotMutex, so concurrent first requests start only one worker.
+void SqliteDatabaseManager::ensureSnapshotThread() {
+    if (!snapshotThread.joinable()) {
+        snapshotThread = std::thread(&SqliteDatabaseManager::snapshotWorker, this);
+    }
+}
+
+void SqliteDatabaseManager::snapshotWorker() {
+    std::unique_lock<std::mutex> lock(snapshotMutex);
+    while (!snapshotStopping) {
+        // 1. On-demand requests take priority over the periodic schedule
+        if (!snapshotQueue.empty()) {
+            SnapshotJob job = std::move(snapshotQueue.front());
+            snapshotQueue.pop_front();
+            lock.unlock();
+            job.done.set_value(backupTo(job.path, job.pagesPerStep));
+            lock.lock();
+            continue;
+        }
+
+        // 2. Periodic snapshot, once its time has come
+        if (periodicSnapshots && std::chrono::steady_clock::now() >= nextPeriodicSnapshot) {
+            std::string path = periodicPath;
+            int pagesPerStep = periodicPagesPerStep;
+            nextPeriodicSnapshot = std::chrono::steady_clock::now() + periodicInterval;
+            lock.unlock();
+            backupTo(path, pagesPerStep);
+            lock.lock();
+            continue;
+        }
+
+        // 3. Sleep until the next request or the next periodic snapshot
+        if (periodicSnapshots) {
+            snapshotCv.wait_until(lock, nextPeriodicSnapshot);
+        } else {
+            snapshotCv.wait(lock);
+        }
+    }
+}
+
+bool SqliteDatabaseManager::backupTo(const std::string& path, int pagesPerStep) {
+    // Copy into a temporary file first so readers never see a half-written snapshot.
+    std::string tmpPath = path + ".tmp";
+    std::remove(tmpPath.c_str());
+
+    sqlite3* dest;
+    if (sqlite3_open_v2(tmpPath.c_str(), &dest, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK) {
+        std::cerr << "Snapshot error: " << sqlite3_errmsg(dest) << std::endl;
+        sqlite3_close(dest);
+        return false;
+    }
+
+    sqlite3_backup* backup = sqlite3_backup_init(dest, "main", db, "main");
+    if (!backup) {
+        std::cerr << "Snapshot error: " << sqlite3_errmsg(dest) << std::endl;
+        sqlite3_close(dest);
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    // BUSY/LOCKED only mean a writer holds the database right now; back off and retry.
+    int rc;
+    do {
+        rc = sqlite3_backup_step(backup, pagesPerStep);
+        if (rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED) {
+            std::this_thread::sleep_for(kSnapshotStepPause);
+        }
+    } while (!snapshotStopping && (rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED));
+    sqlite3_backup_finish(backup);
+
+    bool success = (rc == SQLITE_DONE);
+    if (!success && !snapshotStopping) {
+        std::cerr << "Snapshot error: " << sqlite3_errstr(rc) << std::endl;
+    }
+    sqlite3_close(dest);
+
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows.
+    if (success) std::remove(path.c_str());
+#endif
+    if (!success || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
 } 
\ No newline at end of file
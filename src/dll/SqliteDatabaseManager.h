@@ -3,37 +3,106 @@
 
 #include "IDatabaseManager.h"
 #include <sqlite3.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 // Concrete implementation of the IDatabaseManager interface for SQLite.
 class SqliteDatabaseManager : public IDatabaseManager {
 public:
-    SqliteDatabaseManager(const std::string& db_name);
+    SqliteDatabaseManager(const std::string& db_name, bool readOnly = false);
     ~SqliteDatabaseManager() override;
 
     void initialize() override;
 
     // Flight Management
-    bool addFlight(const Flight& flight) override;
+    std::optional<int> addFlight(const Flight& flight) override;
     std::vector<Flight> searchFlights(const std::string& origin, const std::string& destination) override;
+    std::pmr::vector<PmrFlight> searchFlights(const std::string& origin, const std::string& destination, std::pmr::memory_resource* resource) override;
     std::optional<Flight> getFlightById(int flightId) override;
     std::vector<Flight> getAllFlights() override;
+    std::optional<std::vector<Flight>> getCommittedFlights() override;
+    std::optional<Flight> getCommittedFlight(int flightId) override;
     bool updateFlightSeatCount(int flightId, int change) override;
 
+    // Pricing
+    std::optional<FlightPricingColumns> loadPricingColumns() override;
+    bool updateFlightPrices(const std::vector<int>& flightIds, const std::vector<double>& prices) override;
+
     // Booking Management
     std::optional<int> addBooking(int flightId, const std::string& passengerName, const std::string& passengerEmail) override;
     std::optional<Booking> getBookingById(int bookingId) override;
     bool deleteBooking(int bookingId) override;
     std::vector<Booking> getBookingsForPassenger(const std::string& passengerEmail) override;
+    std::pmr::vector<PmrBooking> getBookingsForPassenger(const std::string& passengerEmail, std::pmr::memory_resource* resource) override;
+
+    // Waitlist Management
+    std::optional<int> addWaitlistEntry(int flightId, const std::string& passengerName, const std::string& passengerEmail) override;
+    bool deleteWaitlistEntry(int entryId) override;
+    std::vector<WaitlistEntry> getWaitlistEntries() override;
+
+    // Seat Hold Management
+    std::optional<int> addSeatHold(const SeatHold& hold) override;
+    bool deleteSeatHold(int holdId) override;
+    std::vector<SeatHold> getSeatHolds() override;
+
+    // Reporting
+    std::vector<RouteStats> getRouteDailyStats() override;
+    std::vector<RouteStats> recomputeRouteDailyStats() override;
     
     // Transaction Management
     bool beginTransaction() override;
     bool commitTransaction() override;
     bool rollbackTransaction() override;
 
+    // Online Snapshots
+    // Copies are made with the SQLite backup API on a background thread, `pagesPerStep`
+    // pages at a time, so the booking writer is only ever blocked for one short step.
+    void startPeriodicSnapshots(const std::string& path, std::chrono::seconds interval, int pagesPerStep = 100);
+    void stopPeriodicSnapshots();
+    std::future<bool> requestSnapshot(const std::string& path, int pagesPerStep = 100);
+    // Opens a finished snapshot as a read-only connection for reporting queries.
+    static std::unique_ptr<SqliteDatabaseManager> openSnapshot(const std::string& path);
+
 private:
+    struct SnapshotJob {
+        std::string path;
+        int pagesPerStep;
+        std::promise<bool> done;
+    };
+
     sqlite3* db;
     std::string dbName;
+
+    // Separate read-only connection, opened on first use. Reads on it never see
+    // another thread's open transaction on `db`.
+    sqlite3* readDb = nullptr;
+    std::mutex readMutex;
+
+    std::thread snapshotThread;
+    std::mutex snapshotMutex;
+    std::condition_variable snapshotCv;
+    std::deque<SnapshotJob> snapshotQueue;
+    std::atomic<bool> snapshotStopping{false};
+    bool periodicSnapshots = false;
+    std::string periodicPath;
+    std::chrono::seconds periodicInterval{0};
+    int periodicPagesPerStep = 100;
+    std::chrono::steady_clock::time_point nextPeriodicSnapshot;
+
+    bool openReadConnection();
+    void ensureSnapshotThread();
+    void snapshotWorker();
+    bool backupTo(const std::string& path, int pagesPerStep);
     bool execute(const std::string& sql);
+    bool hasColumn(const std::string& table, const std::string& column);
+    bool hasTable(const std::string& table);
+    void initializeRouteStats();
 };
 
 #endif // SQLITE_DATABASE_MANAGER_H 
\ No newline at end of file
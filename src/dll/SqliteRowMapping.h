@@ -0,0 +1,145 @@
+#ifndef SQLITE_ROW_MAPPING_H
+#define SQLITE_ROW_MAPPING_H
+
+#include <sqlite3.h>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Compile-time row mapping for SQLite statements.
+// A RowMapper is a constexpr list of (column name, struct member) pairs. It generates the
+// SELECT column list for a query and extracts each row into the struct with one unrolled
+// sequence of sqlite3_column_* calls, so a query only fetches the columns its caller needs.
+
+template <typename T, typename M>
+struct Column {
+    const char* name;
+    M T::* member;
+};
+
+template <typename T, typename M>
+constexpr Column<T, M> column(const char* name, M T::* member) {
+    return Column<T, M>{name, member};
+}
+
+inline void readValue(sqlite3_stmt* stmt, int index, int& out) {
+    out = sqlite3_column_int(stmt, index);
+}
+
+inline void readValue(sqlite3_stmt* stmt, int index, long long& out) {
+    out = sqlite3_column_int64(stmt, index);
+}
+
+inline void readValue(sqlite3_stmt* stmt, int index, double& out) {
+    out = sqlite3_column_double(stmt, index);
+}
+
+// Any string type, so pmr strings are filled through their own allocator.
+template <typename Allocator>
+void readValue(sqlite3_stmt* stmt, int index, std::basic_string<char, std::char_traits<char>, Allocator>& out) {
+    const unsigned char* text = sqlite3_column_text(stmt, index);
+    out.assign(reinterpret_cast<const char*>(text), sqlite3_column_bytes(stmt, index));
+}
+
+template <typename T, typename... Members>
+class RowMapper {
+public:
+    constexpr explicit RowMapper(Column<T, Members>... cols) : columns(cols...) {}
+
+    // Comma-separated column names, in extraction order.
+    std::string columnList() const {
+        std::string list;
+        std::apply([&list](const auto&... col) {
+            ((list += (list.empty() ? "" : ", "), list += col.name), ...);
+        }, columns);
+        return list;
+    }
+
+    // Members not in the projection are value-initialized.
+    T read(sqlite3_stmt* stmt) const {
+        T row{};
+        readInto(stmt, row);
+        return row;
+    }
+
+    // Fills a row that already exists, e.g. one constructed in place with an allocator.
+    void readInto(sqlite3_stmt* stmt, T& row) const {
+        readColumns(stmt, row, std::index_sequence_for<Members...>{});
+    }
+
+private:
+    std::tuple<Column<T, Members>...> columns;
+
+    template <size_t... I>
+    void readColumns(sqlite3_stmt* stmt, T& row, std::index_sequence<I...>) const {
+        (readValue(stmt, (int)I, row.*(std::get<I>(columns).member)), ...);
+    }
+};
+
+template <typename T, typename... Members>
+constexpr RowMapper<T, Members...> makeRowMapper(Column<T, Members>... cols) {
+    return RowMapper<T, Members...>(cols...);
+}
+
+inline void bindValue(sqlite3_stmt* stmt, int index, int value) {
+    sqlite3_bind_int(stmt, index, value);
+}
+
+inline void bindValue(sqlite3_stmt* stmt, int index, long long value) {
+    sqlite3_bind_int64(stmt, index, value);
+}
+
+inline void bindValue(sqlite3_stmt* stmt, int index, double value) {
+    sqlite3_bind_double(stmt, index, value);
+}
+
+// Bound without copying; the string must outlive the statement's execution.
+inline void bindValue(sqlite3_stmt* stmt, int index, const std::string& value) {
+    sqlite3_bind_text(stmt, index, value.c_str(), -1, SQLITE_STATIC);
+}
+
+// Binds a typed parameter pack to the statement's ?1..?N placeholders in order.
+template <typename... Args>
+struct StatementBinder {
+    static void bind([[maybe_unused]] sqlite3_stmt* stmt, const Args&... args) {
+        [[maybe_unused]] int index = 1;
+        (bindValue(stmt, index++, args), ...);
+    }
+};
+
+// Appends each result row to `rows`. Rows are constructed in place, so an allocator-aware
+// container (std::pmr::vector) hands its memory resource to every element.
+template <typename Container, typename T, typename... Members, typename... Args>
+void appendRows(sqlite3* db, const std::string& sql, const RowMapper<T, Members...>& mapper, Container& rows, const Args&... args) {
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return;
+    StatementBinder<Args...>::bind(stmt, args...);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        mapper.readInto(stmt, rows.emplace_back());
+    }
+    sqlite3_finalize(stmt);
+}
+
+template <typename T, typename... Members, typename... Args>
+std::vector<T> queryRows(sqlite3* db, const std::string& sql, const RowMapper<T, Members...>& mapper, const Args&... args) {
+    std::vector<T> rows;
+    appendRows(db, sql, mapper, rows, args...);
+    return rows;
+}
+
+template <typename T, typename... Members, typename... Args>
+std::optional<T> queryRow(sqlite3* db, const std::string& sql, const RowMapper<T, Members...>& mapper, const Args&... args) {
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return std::nullopt;
+    StatementBinder<Args...>::bind(stmt, args...);
+    std::optional<T> row;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        row = mapper.read(stmt);
+    }
+    sqlite3_finalize(stmt);
+    return row;
+}
+
+#endif // SQLITE_ROW_MAPPING_H 
\ No newline at end of file
@@ -46,6 +46,7 @@
 #include "ui/ConsoleUI.h"
 #include <iostream>
 #include <memory>
+#include <chrono>
 
 int main() {
     try {
@@ -53,6 +54,9 @@ int main() {
         auto dbManager = std::make_unique<SqliteDatabaseManager>("flights.db");
         dbManager->initialize();
 
+        // Keep an online snapshot for backups and reporting; safe to copy while running.
+        dbManager->startPeriodicSnapshots("flights.snapshot.db", std::chrono::minutes(15));
+
         // 2. Create the Business Logic Layer, injecting the DAL.
         ReservationService service(std::move(dbManager));
 
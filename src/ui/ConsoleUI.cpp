@@ -3,8 +3,17 @@
 #include "../core/models.h"
 #include <iostream>
 #include <iomanip>
+#include <chrono>
 
-ConsoleUI::ConsoleUI(ReservationService& service) : service(service) {}
+// How long a seat stays held while the passenger enters their details.
+static const int kCheckoutHoldMinutes = 5;
+
+ConsoleUI::ConsoleUI(ReservationService& service) : service(service) {
+    service.subscribeToPromotions([](const WaitlistEntry& entry, int bookingId) {
+        std::cout << "\n[Waitlist] " << entry.passengerName << " (" << entry.passengerEmail
+                  << ") now has a confirmed seat. Booking ID: " << bookingId << "\n";
+    });
+}
 
 void ConsoleUI::run() {
     while (true) {
@@ -38,13 +47,19 @@ void ConsoleUI::showAdminMenu() {
                   << "========================================\n"
                   << "1. Add New Flight\n"
                   << "2. View All Flights\n"
-                  << "3. Back to Main Menu\n"
+                  << "3. Reprice All Flights\n"
+                  << "4. View Route Report\n"
+                  << "5. Verify Route Statistics\n"
+                  << "6. Back to Main Menu\n"
                   << "----------------------------------------\n";
         int choice = getIntegerInput("Enter your choice: ");
         switch (choice) {
             case 1: addFlight(); break;
             case 2: viewAllFlights(); break;
-            case 3: return;
+            case 3: repriceFlights(); break;
+            case 4: viewRouteReport(); break;
+            case 5: verifyRouteStats(); break;
+            case 6: return;
             default: std::cout << "Invalid choice.\n"; pressEnterToContinue();
         }
     }
@@ -59,14 +74,16 @@ void ConsoleUI::showPassengerMenu() {
                   << "1. Search & Book a Flight\n"
                   << "2. View My Bookings\n"
                   << "3. Cancel a Booking\n"
-                  << "4. Back to Main Menu\n"
+                  << "4. Leave a Waitlist\n"
+                  << "5. Back to Main Menu\n"
                   << "----------------------------------------\n";
         int choice = getIntegerInput("Enter your choice: ");
         switch (choice) {
             case 1: searchAndBookFlight(); break;
             case 2: viewMyBookings(); break;
             case 3: cancelBooking(); break;
-            case 4: return;
+            case 4: leaveWaitlist(); break;
+            case 5: return;
             default: std::cout << "Invalid choice.\n"; pressEnterToContinue();
         }
     }
@@ -111,6 +128,36 @@ void ConsoleUI::viewAllFlights() {
     pressEnterToContinue();
 }
 
+void ConsoleUI::repriceFlights() {
+    clearScreen();
+    std::cout << "--- Reprice All Flights ---\n";
+    auto changed = service.repriceAllFlights();
+    if (changed) {
+        std::cout << "\nRepricing complete. " << *changed << " fare(s) updated.\n";
+    } else {
+        std::cout << "\nRepricing failed. No fares were changed.\n";
+    }
+    pressEnterToContinue();
+}
+
+void ConsoleUI::viewRouteReport() {
+    clearScreen();
+    std::cout << "--- Route Report ---\n";
+    displayRouteStats(service.getRouteReport());
+    pressEnterToContinue();
+}
+
+void ConsoleUI::verifyRouteStats() {
+    clearScreen();
+    std::cout << "--- Verify Route Statistics ---\n";
+    if (service.verifyRouteStats()) {
+        std::cout << "\nRoute statistics match the booking records.\n";
+    } else {
+        std::cout << "\nRoute statistics are out of date. See the errors above.\n";
+    }
+    pressEnterToContinue();
+}
+
 void ConsoleUI::searchAndBookFlight() {
     clearScreen();
     std::cout << "--- Search & Book a Flight ---\n";
@@ -133,6 +180,12 @@ void ConsoleUI::searchAndBookFlight() {
     
     int flightId = getIntegerInput("\nEnter the ID of the flight to book (0 to cancel): ");
     if (flightId == 0) return;
+
+    // Hold the seat while the passenger fills in their details.
+    auto hold = service.holdSeats(flightId, 1, std::chrono::minutes(kCheckoutHoldMinutes));
+    if (hold) {
+        std::cout << "A seat is held for you for " << kCheckoutHoldMinutes << " minutes.\n";
+    }
     
     std::string name, email;
     std::cout << "Enter your full name: ";
@@ -141,11 +194,31 @@ void ConsoleUI::searchAndBookFlight() {
     std::cout << "Enter your email address: ";
     std::getline(std::cin, email);
     
-    auto bookingId = service.bookFlight(flightId, name, email);
-    if (bookingId) {
-        std::cout << "\nBooking successful! Your Booking ID is: " << *bookingId << "\n";
-    } else {
-        std::cout << "\nBooking failed. The flight may be full or does not exist.\n";
+    if (hold) {
+        auto bookingIds = service.confirmHold(*hold, {Passenger{name, email}});
+        if (bookingIds) {
+            std::cout << "\nBooking successful! Your Booking ID is: " << bookingIds->front() << "\n";
+        } else {
+            std::cout << "\nBooking failed. Please search again and retry your booking.\n";
+        }
+        pressEnterToContinue();
+        return;
+    }
+
+    std::cout << "\nBooking failed. The flight may be full or does not exist.\n"
+              << "Join the waitlist for this flight? (y/n): ";
+    char confirm;
+    std::cin >> confirm;
+    clearInputBuffer();
+
+    if (confirm == 'y' || confirm == 'Y') {
+        auto entryId = service.joinWaitlist(flightId, name, email);
+        if (entryId) {
+            std::cout << "\nYou are on the waitlist. Your Waitlist ID is: " << *entryId << "\n"
+                      << "You will be booked automatically when a seat is cancelled.\n";
+        } else {
+            std::cout << "\nCould not join the waitlist.\n";
+        }
     }
     pressEnterToContinue();
 }
@@ -185,6 +258,19 @@ void ConsoleUI::cancelBooking() {
     pressEnterToContinue();
 }
 
+void ConsoleUI::leaveWaitlist() {
+    clearScreen();
+    std::cout << "--- Leave a Waitlist ---\n";
+
+    int entryId = getIntegerInput("Enter your Waitlist ID: ");
+    if (service.leaveWaitlist(entryId)) {
+        std::cout << "\nYou have been removed from the waitlist.\n";
+    } else {
+        std::cout << "\nRemoval failed. Check the Waitlist ID.\n";
+    }
+    pressEnterToContinue();
+}
+
 void ConsoleUI::displayFlights(const std::vector<Flight>& flights) {
     if (flights.empty()) {
         std::cout << "\nNo flights to display.\n";
@@ -239,4 +325,34 @@ void ConsoleUI::displayBookings(const std::vector<Booking>& bookings) {
                   << std::setw(25) << b.passengerName 
                   << "\n";
     }
+}
+
+void ConsoleUI::displayRouteStats(const std::vector<RouteStats>& stats) {
+    if (stats.empty()) {
+        std::cout << "\nNo route statistics to display.\n";
+        return;
+    }
+
+    std::cout << "\n" << std::left
+              << std::setw(15) << "Origin"
+              << std::setw(15) << "Destination"
+              << std::setw(9) << "Flights"
+              << std::setw(10) << "Load (%)"
+              << std::setw(14) << "Revenue ($)"
+              << std::setw(10) << "Bookings"
+              << std::setw(10) << "Cancelled"
+              << "\n" << std::string(83, '-') << "\n";
+
+    for (const auto& s : stats) {
+        double load = s.seatsOffered > 0 ? 100.0 * s.seatsSold / s.seatsOffered : 0.0;
+        std::cout << std::left
+                  << std::setw(15) << s.origin
+                  << std::setw(15) << s.destination
+                  << std::setw(9) << s.flights
+                  << std::fixed << std::setprecision(1) << std::setw(10) << load
+                  << std::setprecision(2) << std::setw(14) << s.revenue
+                  << std::setw(10) << s.bookings
+                  << std::setw(10) << s.cancellations
+                  << "\n";
+    }
 } 
\ No newline at end of file
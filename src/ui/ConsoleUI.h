@@ -21,15 +21,20 @@ private:
     // Admin Actions
     void addFlight();
     void viewAllFlights();
+    void repriceFlights();
+    void viewRouteReport();
+    void verifyRouteStats();
 
     // Passenger Actions
     void searchAndBookFlight();
     void viewMyBookings();
     void cancelBooking();
+    void leaveWaitlist();
 
     // Display Helpers
     void displayFlights(const std::vector<Flight>& flights);
     void displayBookings(const std::vector<Booking>& bookings);
+    void displayRouteStats(const std::vector<RouteStats>& stats);
 };
 
 #endif // CONSOLE_UI_H 
\ No newline at end of file